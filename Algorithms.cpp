@@ -1,343 +1,3424 @@
 #include "Algorithms.hpp"
+#include "ShortestPathCache.hpp"
+#include <mutex>
 
 namespace ariel {
 
+    constexpr long long Algorithms::UNREACHABLE;
+    constexpr size_t ShortestPathTree::NO_PARENT;
+    constexpr size_t BreadthFirstTree::UNVISITED;
+    constexpr size_t Matching::UNMATCHED;
+
+    namespace {
+        const size_t NO_PARENT = ShortestPathTree::NO_PARENT;
+
+        // Largest edge weight for which shortestPath prefers Dial's buckets over the radix heap
+        const int DIAL_MAX_WEIGHT = 255;
+
+        // Fewest edges for which graphs with negative weights use the parallel Bellman-Ford (with more than one worker)
+        const size_t PARALLEL_BELLMAN_FORD_MIN_EDGES = 1 << 15;
+
+        void checkVertices(const Adjacency &adj, int s, int v) {
+            size_t vertices = adj.vertexCount();
+            if (s < 0 || v < 0 || static_cast<size_t>(s) >= vertices || static_cast<size_t>(v) >= vertices) {
+                throw std::invalid_argument("Invalid vertex: vertex does not exist.");
+            }
+        }
+
+        void checkNonNegative(const Graph &graph) {
+            if (graph.weightStatistics().negativeEdges > 0) {
+                throw std::invalid_argument("Dijkstra requires non-negative edge weights.");
+            }
+        }
+
+        /*
+        Bellman-Ford-Tarjan over the CSR arrays: a FIFO queue Bellman-Ford that keeps the shortest path tree as a preorder
+        list with depths. When the distance of w improves, its subtree is out of date, so those vertices leave the tree
+        (and are skipped when they come off the queue) until they improve again. If the edge u->w improving w starts in
+        the subtree of w, the tree path w..u plus that edge is a negative cycle, which usually shows up after a few passes
+        instead of after |V| full rounds. Returns the cycle (first vertex repeated at the end), empty if none is reachable.
+
+        With source == NO_PARENT the search starts from a virtual root (index |V| of the list) with a zero-weight edge to
+        every vertex, so every negative cycle of the graph is reachable. Vertices flagged in removed are left out.
+        */
+        vector<size_t> tarjanBellmanFord(const Adjacency &adj, size_t source, vector<long long> &dist, vector<size_t> &parent,
+                                         const vector<char> *removed = nullptr) {
+            const size_t NIL = ShortestPathTree::NO_PARENT;
+            size_t vertices = adj.vertexCount();
+            vector<size_t> next(vertices + 1, NIL), previous(vertices + 1, NIL), depth(vertices + 1, 0);
+            vector<char> inTree(vertices, 0), queued(vertices, 0);
+            queue<size_t> pending;
+            if (source != NIL) {
+                dist[source] = 0;
+                inTree[source] = 1;
+                queued[source] = 1;
+                pending.push(source);
+            } else {
+                size_t last = vertices;
+                for (size_t v = 0; v < vertices; v++) {
+                    if (removed != nullptr && (*removed)[v]) {
+                        continue;
+                    }
+                    dist[v] = 0;
+                    depth[v] = 1;
+                    inTree[v] = 1;
+                    queued[v] = 1;
+                    pending.push(v);
+                    next[last] = v;
+                    previous[v] = last;
+                    last = v;
+                }
+            }
+            while (!pending.empty()) {
+                size_t u = pending.front();
+                pending.pop();
+                queued[u] = 0;
+                if (!inTree[u]) {
+                    continue;
+                }
+                for (size_t e = adj.offsets[u]; e < adj.offsets[u + 1]; e++) {
+                    size_t w = adj.targets[e];
+                    long long candidate = dist[u] + adj.weights[e];
+                    if (candidate >= dist[w] || (removed != nullptr && (*removed)[w])) {
+                        continue;
+                    }
+                    if (inTree[w]) {
+                        // Walk the subtree of w (the vertices after it with a larger depth), disposing of it
+                        size_t x = next[w];
+                        bool cycle = w == u;
+                        while (!cycle && x != NIL && depth[x] > depth[w]) {
+                            cycle = x == u;
+                            inTree[x] = 0;
+                            x = next[x];
+                        }
+                        if (cycle) {
+                            vector<size_t> found;
+                            for (size_t v = u; v != w; v = parent[v]) {
+                                found.push_back(v);
+                            }
+                            found.push_back(w);
+                            reverse(found.begin(), found.end());
+                            found.push_back(w);
+                            return found;
+                        }
+                        next[previous[w]] = x;
+                        if (x != NIL) {
+                            previous[x] = previous[w];
+                        }
+                    }
+                    // w becomes a leaf right after u in the preorder list
+                    dist[w] = candidate;
+                    parent[w] = u;
+                    depth[w] = depth[u] + 1;
+                    inTree[w] = 1;
+                    previous[w] = u;
+                    next[w] = next[u];
+                    if (next[u] != NIL) {
+                        previous[next[u]] = w;
+                    }
+                    next[u] = w;
+                    if (!queued[w]) {
+                        queued[w] = 1;
+                        pending.push(w);
+                    }
+                }
+            }
+            return vector<size_t>();
+        }
+
+        // Shortest path tree for any weights. Returns false if a negative cycle is reachable from the source.
+        bool bellmanFord(const Adjacency &adj, size_t source, vector<long long> &dist, vector<size_t> &parent) {
+            return tarjanBellmanFord(adj, source, dist, parent).empty();
+        }
+
+        /*
+        Bellman-Ford in rounds over a frontier: every round relaxes the out-edges of the vertices whose distance dropped in
+        the previous one, in parallel, lowering distances with an atomic min. Reading distances lowered earlier in the
+        same round only speeds things up, so without a negative cycle nothing changes after |V| - 1 rounds and a
+        non-empty frontier at round |V| proves one. Parents are not recorded during the rounds: the tight edges
+        (dist[u] + w == dist[v]) can offer several predecessors with the same distance, and threads relaxing them race,
+        so the parent left behind would depend on the schedule. A BFS over the tight edges from the source sets them
+        afterwards instead, visiting each vertex once, so the parents form a tree and are the same on every run.
+        Returns false on a negative cycle.
+        */
+        bool frontierBellmanFord(const Adjacency &adj, size_t source, vector<long long> &dist, vector<size_t> &parent) {
+            size_t vertices = adj.vertexCount();
+            vector<atomic<long long>> distance(vertices);
+            vector<atomic<char>> queued(vertices);
+            for (size_t v = 0; v < vertices; v++) {
+                distance[v].store(Algorithms::UNREACHABLE, memory_order_relaxed);
+                queued[v].store(0, memory_order_relaxed);
+            }
+            distance[source].store(0, memory_order_relaxed);
+            vector<size_t> frontier(1, source);
+            vector<vector<size_t>> improved(Parallel::workers());
+            for (size_t round = 0; !frontier.empty(); round++) {
+                if (round == vertices) {
+                    return false;
+                }
+                Parallel::forEach(frontier.size(), 64, [&](size_t worker, size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; i++) {
+                        size_t u = frontier[i];
+                        long long du = distance[u].load(memory_order_relaxed);
+                        for (size_t e = adj.offsets[u]; e < adj.offsets[u + 1]; e++) {
+                            size_t v = adj.targets[e];
+                            if (Parallel::atomicMin(distance[v], du + adj.weights[e]) &&
+                                queued[v].exchange(1, memory_order_relaxed) == 0) {
+                                improved[worker].push_back(v);
+                            }
+                        }
+                    }
+                });
+                frontier.clear();
+                for (auto &local : improved) {
+                    for (size_t v : local) {
+                        queued[v].store(0, memory_order_relaxed);
+                        frontier.push_back(v);
+                    }
+                    local.clear();
+                }
+            }
+
+            for (size_t v = 0; v < vertices; v++) {
+                dist[v] = distance[v].load(memory_order_relaxed);
+            }
+            vector<char> reached(vertices, 0);
+            queue<size_t> pending;
+            reached[source] = 1;
+            pending.push(source);
+            while (!pending.empty()) {
+                size_t u = pending.front();
+                pending.pop();
+                for (size_t e = adj.offsets[u]; e < adj.offsets[u + 1]; e++) {
+                    size_t v = adj.targets[e];
+                    if (!reached[v] && dist[u] + adj.weights[e] == dist[v]) {
+                        reached[v] = 1;
+                        parent[v] = u;
+                        pending.push(v);
+                    }
+                }
+            }
+            return true;
+        }
+
+        // Total weight of a closed vertex list
+        long long cycleWeight(const Graph &graph, const vector<size_t> &cycle) {
+            long long weight = 0;
+            for (size_t i = 0; i + 1 < cycle.size(); i++) {
+                weight += graph.matrix[cycle[i]][cycle[i + 1]];
+            }
+            return weight;
+        }
+
+        /*
+        Dial's algorithm: Dijkstra with a circular array of maxWeight + 1 buckets, one per distance value.
+        Every tentative distance lies within maxWeight of the distance being settled, so the buckets never collide.
+        Stale entries are skipped when their stored distance no longer matches.
+        */
+        void dialDijkstra(const Adjacency &adj, size_t source, int maxWeight, vector<long long> &dist, vector<size_t> &parent) {
+            size_t width = static_cast<size_t>(maxWeight) + 1;
+            vector<vector<size_t>> buckets(width);
+            buckets[0].push_back(source);
+            dist[source] = 0;
+            size_t pending = 1;
+            for (long long d = 0; pending > 0; d++) {
+                vector<size_t> &bucket = buckets[static_cast<size_t>(d) % width];
+                while (!bucket.empty()) {
+                    size_t u = bucket.back();
+                    bucket.pop_back();
+                    pending--;
+                    if (dist[u] != d) {
+                        continue;
+                    }
+                    for (size_t e = adj.offsets[u]; e < adj.offsets[u + 1]; e++) {
+                        size_t t = adj.targets[e];
+                        long long candidate = d + adj.weights[e];
+                        if (candidate < dist[t]) {
+                            dist[t] = candidate;
+                            parent[t] = u;
+                            buckets[static_cast<size_t>(candidate) % width].push_back(t);
+                            pending++;
+                        }
+                    }
+                }
+            }
+        }
+
+        /*
+        Radix heap: a monotone priority queue for integer keys.
+        Bucket i holds keys whose highest bit differing from the last extracted minimum is bit i - 1 (bucket 0: equal keys).
+        When bucket 0 runs dry the first non-empty bucket is redistributed around its minimum, so each key moves down at most 64 times.
+        */
+        class RadixHeap {
+        public:
+            RadixHeap() : buckets(65), last(0), count(0) {}
+
+            bool empty() const {
+                return count == 0;
+            }
+
+            void push(unsigned long long key, size_t vertex) {
+                buckets[bucketOf(key)].push_back(make_pair(key, vertex));
+                count++;
+            }
+
+            pair<unsigned long long, size_t> pop() {
+                if (buckets[0].empty()) {
+                    size_t i = 1;
+                    while (buckets[i].empty()) {
+                        i++;
+                    }
+                    unsigned long long smallest = buckets[i][0].first;
+                    for (const auto &item : buckets[i]) {
+                        smallest = min(smallest, item.first);
+                    }
+                    last = smallest;
+                    for (const auto &item : buckets[i]) {
+                        buckets[bucketOf(item.first)].push_back(item);
+                    }
+                    buckets[i].clear();
+                }
+                pair<unsigned long long, size_t> top = buckets[0].back();
+                buckets[0].pop_back();
+                count--;
+                return top;
+            }
+
+        private:
+            vector<vector<pair<unsigned long long, size_t>>> buckets;
+            unsigned long long last;
+            size_t count;
+
+            size_t bucketOf(unsigned long long key) const {
+                return key == last ? 0 : static_cast<size_t>(64 - __builtin_clzll(key ^ last));
+            }
+        };
+
+        void radixHeapDijkstra(const Adjacency &adj, size_t source, vector<long long> &dist, vector<size_t> &parent) {
+            RadixHeap heap;
+            dist[source] = 0;
+            heap.push(0, source);
+            while (!heap.empty()) {
+                pair<unsigned long long, size_t> top = heap.pop();
+                size_t u = top.second;
+                long long d = static_cast<long long>(top.first);
+                if (dist[u] != d) {
+                    continue;
+                }
+                for (size_t e = adj.offsets[u]; e < adj.offsets[u + 1]; e++) {
+                    size_t t = adj.targets[e];
+                    long long candidate = d + adj.weights[e];
+                    if (candidate < dist[t]) {
+                        dist[t] = candidate;
+                        parent[t] = u;
+                        heap.push(static_cast<unsigned long long>(candidate), t);
+                    }
+                }
+            }
+        }
+
+        // Kahn's algorithm: order is used as the queue of vertices whose in-edges are all processed.
+        // Returns false (with a partial order) if the graph has a directed cycle.
+        bool kahnOrder(const Graph &graph, vector<size_t> &order) {
+            const Adjacency &out = graph.outEdges();
+            const Adjacency &in = graph.inEdges();
+            size_t vertices = out.vertexCount();
+            vector<size_t> remaining(vertices);
+            order.clear();
+            order.reserve(vertices);
+            for (size_t v = 0; v < vertices; v++) {
+                remaining[v] = in.offsets[v + 1] - in.offsets[v];
+                if (remaining[v] == 0) {
+                    order.push_back(v);
+                }
+            }
+            for (size_t head = 0; head < order.size(); head++) {
+                size_t u = order[head];
+                for (size_t e = out.offsets[u]; e < out.offsets[u + 1]; e++) {
+                    if (--remaining[out.targets[e]] == 0) {
+                        order.push_back(out.targets[e]);
+                    }
+                }
+            }
+            return order.size() == vertices;
+        }
+
+        // Topological order of a graph known to be acyclic, or found to be by this call (recorded on the graph)
+        bool acyclicOrder(Graph &graph, vector<size_t> &order) {
+            if (graph.acyclicity() == Acyclicity::Cyclic) {
+                return false;
+            }
+            bool acyclic = kahnOrder(graph, order);
+            graph.recordAcyclicity(acyclic);
+            return acyclic;
+        }
+
+        // Relax the out-edges of every vertex in topological order, keeping the smaller (or larger) distance
+        void dagRelax(const Adjacency &adj, const vector<size_t> &order, size_t source, bool longest,
+                      vector<long long> &dist, vector<size_t> &parent) {
+            dist[source] = 0;
+            size_t first = static_cast<size_t>(find(order.begin(), order.end(), source) - order.begin());
+            for (size_t i = first; i < order.size(); i++) {
+                size_t u = order[i];
+                if (dist[u] == Algorithms::UNREACHABLE) {
+                    continue;
+                }
+                for (size_t e = adj.offsets[u]; e < adj.offsets[u + 1]; e++) {
+                    size_t t = adj.targets[e];
+                    long long candidate = dist[u] + adj.weights[e];
+                    if (dist[t] == Algorithms::UNREACHABLE || (longest ? candidate > dist[t] : candidate < dist[t])) {
+                        dist[t] = candidate;
+                        parent[t] = u;
+                    }
+                }
+            }
+        }
+
+        ShortestPathTree emptyTree(size_t vertices, size_t source) {
+            ShortestPathTree tree;
+            tree.source = source;
+            tree.distance.assign(vertices, Algorithms::UNREACHABLE);
+            tree.parent.assign(vertices, NO_PARENT);
+            return tree;
+        }
+
+        ShortestPathTree dagPaths(Graph &graph, size_t source, bool longest) {
+            const Adjacency &adj = graph.outEdges();
+            if (source >= adj.vertexCount()) {
+                throw std::invalid_argument("Invalid source: vertex does not exist.");
+            }
+            vector<size_t> order;
+            if (!acyclicOrder(graph, order)) {
+                throw std::invalid_argument("Invalid graph: the graph contains a cycle.");
+            }
+            ShortestPathTree tree = emptyTree(adj.vertexCount(), source);
+            dagRelax(adj, order, source, longest, tree.distance, tree.parent);
+            return tree;
+        }
+
+        // Run the shortest path algorithm that suits the graph (see singleSourceShortestPaths)
+        ShortestPathTree buildTree(Graph &graph, size_t source) {
+            const Adjacency &adj = graph.outEdges();
+            ShortestPathTree tree = emptyTree(adj.vertexCount(), source);
+
+            // A DAG needs one pass in topological order. Checking for one is worth it whenever Bellman-Ford is the alternative.
+            const WeightStatistics &stats = graph.weightStatistics();
+            vector<size_t> order;
+            if ((graph.acyclicity() == Acyclicity::Acyclic || stats.negativeEdges > 0) && acyclicOrder(graph, order)) {
+                dagRelax(adj, order, source, false, tree.distance, tree.parent);
+            } else if (stats.negativeEdges == 0 && stats.maxWeight <= DIAL_MAX_WEIGHT) {
+                dialDijkstra(adj, source, stats.maxWeight, tree.distance, tree.parent);
+            } else if (stats.negativeEdges == 0) {
+                radixHeapDijkstra(adj, source, tree.distance, tree.parent);
+            } else if (Parallel::workers() > 1 && adj.edgeCount() >= PARALLEL_BELLMAN_FORD_MIN_EDGES) {
+                tree.negativeCycle = !frontierBellmanFord(adj, source, tree.distance, tree.parent);
+            } else {
+                tree.negativeCycle = !bellmanFord(adj, source, tree.distance, tree.parent);
+            }
+            return tree;
+        }
+
+        // The tree for source, taken from (or added to) the graph's cache when one is attached
+        shared_ptr<const ShortestPathTree> cachedTree(Graph &graph, size_t source) {
+            ShortestPathCache *cache = graph.shortestPathCache();
+            if (cache == nullptr) {
+                return make_shared<const ShortestPathTree>(buildTree(graph, source));
+            }
+            shared_ptr<const ShortestPathTree> tree = cache->find(graph.version(), source);
+            if (!tree) {
+                tree = make_shared<const ShortestPathTree>(buildTree(graph, source));
+                cache->insert(graph.version(), tree);
+            }
+            return tree;
+        }
+
+        // Renumber component labels (each in 0..n-1) in order of each component's smallest vertex
+        Components normalizeComponents(const vector<size_t> &labels) {
+            Components result;
+            result.component.resize(labels.size());
+            vector<size_t> renamed(labels.size(), NO_PARENT);
+            for (size_t v = 0; v < labels.size(); v++) {
+                size_t &name = renamed[labels[v]];
+                if (name == NO_PARENT) {
+                    name = result.count++;
+                }
+                result.component[v] = name;
+            }
+            result.sizes.assign(result.count, 0);
+            for (size_t name : result.component) {
+                result.sizes[name]++;
+            }
+            return result;
+        }
+
+        // Atomically raise target to value, returns true if it was raised
+        bool atomicMax(atomic<size_t> &target, size_t value) {
+            size_t current = target.load(memory_order_relaxed);
+            while (value > current) {
+                if (target.compare_exchange_weak(current, value, memory_order_relaxed)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Lock-free union: hook the larger root under the smaller one with a CAS, retrying when another thread got there first
+        void linkComponents(size_t u, size_t v, vector<atomic<size_t>> &parent) {
+            size_t p1 = parent[u].load();
+            size_t p2 = parent[v].load();
+            while (p1 != p2) {
+                size_t high = max(p1, p2);
+                size_t low = min(p1, p2);
+                size_t highParent = parent[high].load();
+                if (highParent == low) {
+                    break;
+                }
+                if (highParent == high && parent[high].compare_exchange_strong(highParent, low)) {
+                    break;
+                }
+                p1 = parent[parent[high].load()].load();
+                p2 = parent[low].load();
+            }
+        }
+
+        // Point every vertex straight at its root
+        void compressComponents(vector<atomic<size_t>> &parent) {
+            Parallel::forEach(parent.size(), 4096, [&](size_t, size_t begin, size_t end) {
+                for (size_t v = begin; v < end; v++) {
+                    size_t p = parent[v].load();
+                    while (p != parent[p].load()) {
+                        p = parent[p].load();
+                    }
+                    parent[v].store(p);
+                }
+            });
+        }
+
+        // Sum of the degrees (out, plus in when edge directions are ignored) of a list of vertices
+        size_t degreeSum(const Adjacency &out, const Adjacency &in, bool ignoreDirection, const vector<size_t> &list) {
+            size_t sum = 0;
+            for (size_t v : list) {
+                sum += out.offsets[v + 1] - out.offsets[v];
+                if (ignoreDirection) {
+                    sum += in.offsets[v + 1] - in.offsets[v];
+                }
+            }
+            return sum;
+        }
+
+        // Level-synchronous parallel BFS from source over alive vertices, returns the reached set
+        vector<char> parallelReach(const Adjacency &adj, size_t source, const vector<char> &alive) {
+            size_t vertices = adj.vertexCount();
+            vector<atomic<char>> seen(vertices);
+            for (auto &flag : seen) {
+                flag.store(0, memory_order_relaxed);
+            }
+            seen[source].store(1, memory_order_relaxed);
+            vector<size_t> frontier(1, source);
+            vector<vector<size_t>> found(Parallel::workers());
+            while (!frontier.empty()) {
+                Parallel::forEach(frontier.size(), 64, [&](size_t worker, size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; i++) {
+                        size_t u = frontier[i];
+                        for (size_t e = adj.offsets[u]; e < adj.offsets[u + 1]; e++) {
+                            size_t t = adj.targets[e];
+                            if (alive[t] && seen[t].load(memory_order_relaxed) == 0 && seen[t].exchange(1) == 0) {
+                                found[worker].push_back(t);
+                            }
+                        }
+                    }
+                });
+                frontier.clear();
+                for (auto &local : found) {
+                    frontier.insert(frontier.end(), local.begin(), local.end());
+                    local.clear();
+                }
+            }
+            vector<char> reached(vertices);
+            for (size_t v = 0; v < vertices; v++) {
+                reached[v] = seen[v].load(memory_order_relaxed);
+            }
+            return reached;
+        }
+
+        /*
+        Iterative DFS cycle search shared by findDirectedCycle and findUndirectedCycle.
+        With in == nullptr edges are directed, otherwise the neighbours of u are its out-edges followed by
+        its in-edges and the edge back to the DFS parent is skipped.
+        */
+        vector<size_t> findCycle(const Adjacency &out, const Adjacency *in) {
+            const char WHITE = 0, GRAY = 1, BLACK = 2;
+            size_t vertices = out.vertexCount();
+            vector<char> color(vertices, WHITE);
+            vector<size_t> parent(vertices, NO_PARENT);
+            // Frame: vertex and index of its next edge (out-edges first, then in-edges)
+            vector<pair<size_t, size_t>> frames;
+
+            for (size_t start = 0; start < vertices; start++) {
+                if (color[start] != WHITE) {
+                    continue;
+                }
+                color[start] = GRAY;
+                frames.emplace_back(start, 0);
+                while (!frames.empty()) {
+                    size_t u = frames.back().first;
+                    size_t index = frames.back().second++;
+                    size_t outDegree = out.offsets[u + 1] - out.offsets[u];
+                    size_t degree = outDegree;
+                    if (in != nullptr) {
+                        degree += in->offsets[u + 1] - in->offsets[u];
+                    }
+                    if (index == degree) {
+                        // Exit event
+                        color[u] = BLACK;
+                        frames.pop_back();
+                        continue;
+                    }
+                    size_t w = index < outDegree ? out.targets[out.offsets[u] + index]
+                                                 : in->targets[in->offsets[u] + index - outDegree];
+                    if (in != nullptr && w == parent[u]) {
+                        continue;
+                    }
+                    if (color[w] == WHITE) {
+                        // Enter event
+                        color[w] = GRAY;
+                        parent[w] = u;
+                        frames.emplace_back(w, 0);
+                    } else if (color[w] == GRAY) {
+                        vector<size_t> cycle;
+                        for (size_t x = u; x != w; x = parent[x]) {
+                            cycle.push_back(x);
+                        }
+                        cycle.push_back(w);
+                        reverse(cycle.begin(), cycle.end());
+                        cycle.push_back(w);
+                        return cycle;
+                    }
+                }
+            }
+            return vector<size_t>();
+        }
+
+        // Copy of one strongly connected component with its vertices renumbered 0..size-1 in increasing order
+        struct ComponentGraph {
+            vector<size_t> vertices;
+            Adjacency out;
+            Adjacency in;
+        };
+
+        // Split the graph into its strongly connected components with more than one vertex (the only ones with cycles)
+        vector<ComponentGraph> cyclicComponents(Graph &graph) {
+            const Adjacency &out = graph.outEdges();
+            Components scc = Algorithms::stronglyConnectedComponents(graph);
+            vector<ComponentGraph> components(scc.count);
+            vector<size_t> local(scc.component.size());
+            for (size_t v = 0; v < scc.component.size(); v++) {
+                vector<size_t> &vertices = components[scc.component[v]].vertices;
+                local[v] = vertices.size();
+                vertices.push_back(v);
+            }
+
+            vector<ComponentGraph> cyclic;
+            for (ComponentGraph &component : components) {
+                if (component.vertices.size() < 2) {
+                    continue;
+                }
+                size_t size = component.vertices.size();
+                size_t label = scc.component[component.vertices[0]];
+                component.out.offsets.assign(size + 1, 0);
+                component.in.offsets.assign(size + 1, 0);
+                for (size_t x = 0; x < size; x++) {
+                    size_t u = component.vertices[x];
+                    for (size_t e = out.offsets[u]; e < out.offsets[u + 1]; e++) {
+                        if (scc.component[out.targets[e]] == label) {
+                            component.out.targets.push_back(local[out.targets[e]]);
+                            component.out.weights.push_back(out.weights[e]);
+                            component.in.offsets[local[out.targets[e]] + 1]++;
+                        }
+                    }
+                    component.out.offsets[x + 1] = component.out.targets.size();
+                }
+                for (size_t x = 0; x < size; x++) {
+                    component.in.offsets[x + 1] += component.in.offsets[x];
+                }
+                component.in.targets.resize(component.out.targets.size());
+                component.in.weights.resize(component.out.targets.size());
+                vector<size_t> next(component.in.offsets.begin(), component.in.offsets.end() - 1);
+                for (size_t x = 0; x < size; x++) {
+                    for (size_t e = component.out.offsets[x]; e < component.out.offsets[x + 1]; e++) {
+                        size_t slot = next[component.out.targets[e]]++;
+                        component.in.targets[slot] = x;
+                        component.in.weights[slot] = component.out.weights[e];
+                    }
+                }
+                cyclic.push_back(move(component));
+            }
+            return cyclic;
+        }
+
+        // Wide enough for a potential numerator (up to 2 * |V|^2 * INT_MAX) times a cycle length
+        typedef __int128 Exact;
+
+        // numerator / denominator with a positive denominator, compared exactly by cross-multiplying
+        struct Fraction {
+            Exact numerator;
+            Exact denominator;
+        };
+
+        bool operator<(const Fraction &a, const Fraction &b) {
+            return a.numerator * b.denominator < b.numerator * a.denominator;
+        }
+
+        bool operator==(const Fraction &a, const Fraction &b) {
+            return a.numerator * b.denominator == b.numerator * a.denominator;
+        }
+
+        // Is the mean of a lighter than the mean of b (exact, cross-multiplied)
+        bool lowerMean(const Path &a, const Path &b) {
+            return static_cast<Exact>(a.weight) * static_cast<Exact>(b.vertices.size() - 1) <
+                   static_cast<Exact>(b.weight) * static_cast<Exact>(a.vertices.size() - 1);
+        }
+
+        // The cycle through start in a graph where every vertex has one successor, in global vertex numbers and closed
+        Path policyCycle(const ComponentGraph &component, const vector<size_t> &policy, size_t start) {
+            Path cycle;
+            size_t v = start;
+            do {
+                cycle.vertices.push_back(component.vertices[v]);
+                cycle.weight += component.out.weights[policy[v]];
+                v = component.out.targets[policy[v]];
+            } while (v != start);
+            cycle.vertices.push_back(component.vertices[start]);
+            return cycle;
+        }
+
+        /*
+        Karp's minimum mean cycle of a strongly connected component in O(VE) time and O(V^2) memory.
+        walk[k][v] is the lightest walk of exactly k edges from vertex 0 to v. The minimum mean is
+        min over v of max over k of (walk[n][v] - walk[k][v]) / (n - k), and every cycle on the n-edge walk
+        to the minimizing v has that mean.
+        */
+        Path karpMeanCycle(const ComponentGraph &component) {
+            size_t n = component.vertices.size();
+            const long long NONE = LLONG_MAX;
+            vector<long long> walk((n + 1) * n, NONE);
+            vector<size_t> previous((n + 1) * n, 0);
+            walk[0] = 0;
+            for (size_t k = 1; k <= n; k++) {
+                for (size_t u = 0; u < n; u++) {
+                    long long base = walk[(k - 1) * n + u];
+                    if (base == NONE) {
+                        continue;
+                    }
+                    for (size_t e = component.out.offsets[u]; e < component.out.offsets[u + 1]; e++) {
+                        size_t slot = k * n + component.out.targets[e];
+                        if (base + component.out.weights[e] < walk[slot]) {
+                            walk[slot] = base + component.out.weights[e];
+                            previous[slot] = u;
+                        }
+                    }
+                }
+            }
+
+            // Minimize over v the largest (walk[n][v] - walk[k][v]) / (n - k), keeping fractions exact
+            size_t best = n;
+            long long bestNumerator = 0, bestDenominator = 1;
+            for (size_t v = 0; v < n; v++) {
+                if (walk[n * n + v] == NONE) {
+                    continue;
+                }
+                long long numerator = 0, denominator = 0;
+                for (size_t k = 0; k < n; k++) {
+                    if (walk[k * n + v] == NONE) {
+                        continue;
+                    }
+                    long long top = walk[n * n + v] - walk[k * n + v];
+                    long long bottom = static_cast<long long>(n - k);
+                    if (denominator == 0 || top * denominator > numerator * bottom) {
+                        numerator = top;
+                        denominator = bottom;
+                    }
+                }
+                if (best == n || numerator * bestDenominator < bestNumerator * denominator) {
+                    best = v;
+                    bestNumerator = numerator;
+                    bestDenominator = denominator;
+                }
+            }
+
+            // Walk back from best until a vertex repeats, then read the cycle forwards
+            const size_t UNSEEN = static_cast<size_t>(-1);
+            vector<size_t> seenAt(n, UNSEEN);
+            vector<size_t> backwards;
+            size_t v = best;
+            for (size_t k = n; seenAt[v] == UNSEEN; k--) {
+                seenAt[v] = backwards.size();
+                backwards.push_back(v);
+                v = previous[k * n + v];
+            }
+            vector<size_t> local(backwards.begin() + static_cast<ptrdiff_t>(seenAt[v]), backwards.end());
+            local.push_back(v);
+            reverse(local.begin(), local.end());
+            Path cycle;
+            for (size_t i = 0; i < local.size(); i++) {
+                cycle.vertices.push_back(component.vertices[local[i]]);
+                if (i + 1 < local.size()) {
+                    long long lightest = LLONG_MAX;
+                    for (size_t e = component.out.offsets[local[i]]; e < component.out.offsets[local[i] + 1]; e++) {
+                        if (component.out.targets[e] == local[i + 1]) {
+                            lightest = min(lightest, static_cast<long long>(component.out.weights[e]));
+                        }
+                    }
+                    cycle.weight += lightest;
+                }
+            }
+            return cycle;
+        }
+
+        /*
+        Howard's policy iteration for the minimum mean cycle of a strongly connected component. The policy picks one
+        out-edge per vertex, so it is a graph whose walks all end in cycles. Every vertex gets the mean of the cycle it
+        reaches (eta) and a potential relative to it (x). A vertex switches to an edge reaching a lower mean or, among
+        equal means, to one lowering its potential. Once nothing switches, the lightest policy cycle is optimal.
+        Means and potentials are kept as fractions over the length of the cycle they come from and compared by
+        cross-multiplying, so large weights cannot hide a mean gap of 1 / n^2 as a fixed tolerance would.
+        Returns an empty path if the iteration limit is hit, so the caller can fall back to Karp.
+        */
+        Path howardMeanCycle(const ComponentGraph &component, size_t maxIterations) {
+            size_t n = component.vertices.size();
+            const Adjacency &out = component.out;
+            vector<size_t> policy(n);
+            for (size_t u = 0; u < n; u++) {
+                policy[u] = out.offsets[u];
+                for (size_t e = out.offsets[u]; e < out.offsets[u + 1]; e++) {
+                    if (out.weights[e] < out.weights[policy[u]]) {
+                        policy[u] = e;
+                    }
+                }
+            }
+
+            const size_t NEW = 0, ON_PATH = 1, DONE = 2;
+            vector<Fraction> eta(n), potential(n);
+            vector<size_t> state(n), path;
+            for (size_t iteration = 0; iteration < maxIterations; iteration++) {
+                // Evaluate the policy: find its cycles, then the mean and potential of every vertex
+                Path best;
+                fill(state.begin(), state.end(), NEW);
+                for (size_t start = 0; start < n; start++) {
+                    path.clear();
+                    size_t v = start;
+                    while (state[v] == NEW) {
+                        state[v] = ON_PATH;
+                        path.push_back(v);
+                        v = out.targets[policy[v]];
+                    }
+                    if (state[v] == ON_PATH) {
+                        // A new cycle through v: the potential of v is 0 and it passes the cycle's mean backwards
+                        Path cycle = policyCycle(component, policy, v);
+                        Exact length = static_cast<Exact>(cycle.vertices.size() - 1);
+                        if (best.vertices.empty() || lowerMean(cycle, best)) {
+                            best = cycle;
+                        }
+                        eta[v] = Fraction{cycle.weight, length};
+                        potential[v] = Fraction{0, length};
+                        state[v] = DONE;
+                    }
+                    for (size_t i = path.size(); i-- > 0;) {
+                        size_t u = path[i];
+                        if (state[u] == DONE) {
+                            continue;
+                        }
+                        size_t next = out.targets[policy[u]];
+                        // w - eta + x over the cycle length shared by eta and x of next
+                        eta[u] = eta[next];
+                        potential[u] = Fraction{out.weights[policy[u]] * eta[next].denominator - eta[next].numerator +
+                                                    potential[next].numerator,
+                                                eta[next].denominator};
+                        state[u] = DONE;
+                    }
+                }
+
+                // Improve: first toward lower means, then toward lower potentials
+                bool changed = false;
+                for (size_t u = 0; u < n; u++) {
+                    size_t choice = policy[u];
+                    for (size_t e = out.offsets[u]; e < out.offsets[u + 1]; e++) {
+                        if (eta[out.targets[e]] < eta[out.targets[choice]]) {
+                            choice = e;
+                        }
+                    }
+                    if (eta[out.targets[choice]] < eta[u]) {
+                        policy[u] = choice;
+                        changed = true;
+                    }
+                }
+                if (!changed) {
+                    for (size_t u = 0; u < n; u++) {
+                        size_t choice = policy[u];
+                        Fraction lowest = potential[u];
+                        for (size_t e = out.offsets[u]; e < out.offsets[u + 1]; e++) {
+                            size_t v = out.targets[e];
+                            if (!(eta[v] == eta[u])) {
+                                continue;
+                            }
+                            Fraction candidate{out.weights[e] * eta[v].denominator - eta[v].numerator + potential[v].numerator,
+                                               eta[v].denominator};
+                            if (candidate < lowest) {
+                                lowest = candidate;
+                                choice = e;
+                            }
+                        }
+                        if (choice != policy[u]) {
+                            policy[u] = choice;
+                            changed = true;
+                        }
+                    }
+                }
+                if (!changed) {
+                    return best;
+                }
+            }
+            return Path();
+        }
+
         /*
-        Algorithm we are using: Depth-First Search (DFS)
+        Johnson's circuit search for the cycles whose smallest vertex is a given start vertex, with its own workspace
+        so that several start vertices can be searched at once. report gets every cycle in global vertex numbers and
+        returns false to stop the enumeration.
+        With a length bound, blocking would hide cycles that are only short enough from a shallower position, so the
+        bounded search drops it and prunes with the hop distance back to the start instead.
+        */
+        class CircuitSearch {
+        public:
+            CircuitSearch(size_t maxLength, const function<bool(const vector<size_t> &)> &report)
+                : maxLength(maxLength), report(report) {}
+
+            // Returns false if report asked to stop
+            bool run(const ComponentGraph &component, size_t start) {
+                size_t size = component.vertices.size();
+                restrictTo(component, start);
+                blocked.assign(size, 0);
+                blockedBy.resize(size);
+
+                bool keepGoing = true;
+                frames.clear();
+                path.clear();
+                enter(component, start);
+                while (!frames.empty() && keepGoing) {
+                    Frame &frame = frames.back();
+                    if (frame.edge == component.out.offsets[frame.vertex + 1]) {
+                        leave(component);
+                        continue;
+                    }
+                    size_t w = component.out.targets[frame.edge++];
+                    if (!allowed[w]) {
+                        continue;
+                    }
+                    if (w == start) {
+                        if (maxLength == 0 || path.size() <= maxLength) {
+                            frame.found = true;
+                            cycle.clear();
+                            for (size_t x : path) {
+                                cycle.push_back(component.vertices[x]);
+                            }
+                            cycle.push_back(component.vertices[start]);
+                            keepGoing = report(cycle);
+                        }
+                    } else if (!blocked[w] && (maxLength == 0 || path.size() + distance[w] <= maxLength)) {
+                        enter(component, w);
+                    }
+                }
+
+                for (size_t x = start; x < size; x++) {
+                    blockedBy[x].clear();
+                }
+                return keepGoing;
+            }
+
+        private:
+            struct Frame {
+                size_t vertex;
+                size_t edge;
+                // Some cycle through start was closed below this vertex
+                bool found;
+            };
+
+            size_t maxLength;
+            const function<bool(const vector<size_t> &)> &report;
+            vector<char> allowed;
+            vector<size_t> distance;
+            // Unbounded: Johnson's blocked flag. Bounded: on the current path.
+            vector<char> blocked;
+            vector<vector<size_t>> blockedBy;
+            vector<Frame> frames;
+            vector<size_t> path;
+            vector<size_t> cycle;
+            vector<size_t> pending;
+
+            // Keep the vertices >= start that lie on a cycle through start: reachable from it and reaching it back.
+            // distance gets the number of edges from every such vertex back to start.
+            void restrictTo(const ComponentGraph &component, size_t start) {
+                size_t size = component.vertices.size();
+                vector<char> forward(size, 0);
+                forward[start] = 1;
+                pending.assign(1, start);
+                while (!pending.empty()) {
+                    size_t x = pending.back();
+                    pending.pop_back();
+                    for (size_t e = component.out.offsets[x]; e < component.out.offsets[x + 1]; e++) {
+                        size_t w = component.out.targets[e];
+                        if (w > start && !forward[w]) {
+                            forward[w] = 1;
+                            pending.push_back(w);
+                        }
+                    }
+                }
+                allowed.assign(size, 0);
+                distance.assign(size, 0);
+                allowed[start] = 1;
+                pending.assign(1, start);
+                for (size_t head = 0; head < pending.size(); head++) {
+                    size_t x = pending[head];
+                    for (size_t e = component.in.offsets[x]; e < component.in.offsets[x + 1]; e++) {
+                        size_t w = component.in.targets[e];
+                        if (forward[w] && !allowed[w]) {
+                            allowed[w] = 1;
+                            distance[w] = distance[x] + 1;
+                            pending.push_back(w);
+                        }
+                    }
+                }
+            }
+
+            void enter(const ComponentGraph &component, size_t v) {
+                path.push_back(v);
+                blocked[v] = 1;
+                frames.push_back(Frame{v, component.out.offsets[v], false});
+            }
+
+            void leave(const ComponentGraph &component) {
+                Frame frame = frames.back();
+                frames.pop_back();
+                path.pop_back();
+                size_t v = frame.vertex;
+                if (maxLength != 0) {
+                    blocked[v] = 0;
+                } else if (frame.found) {
+                    unblock(v);
+                } else {
+                    // v stays blocked until one of its out-neighbours gets unblocked
+                    for (size_t e = component.out.offsets[v]; e < component.out.offsets[v + 1]; e++) {
+                        vector<size_t> &waiting = blockedBy[component.out.targets[e]];
+                        if (allowed[component.out.targets[e]] && find(waiting.begin(), waiting.end(), v) == waiting.end()) {
+                            waiting.push_back(v);
+                        }
+                    }
+                }
+                if (frame.found && !frames.empty()) {
+                    frames.back().found = true;
+                }
+            }
+
+            void unblock(size_t v) {
+                pending.assign(1, v);
+                while (!pending.empty()) {
+                    size_t x = pending.back();
+                    pending.pop_back();
+                    if (!blocked[x]) {
+                        continue;
+                    }
+                    blocked[x] = 0;
+                    pending.insert(pending.end(), blockedBy[x].begin(), blockedBy[x].end());
+                    blockedBy[x].clear();
+                }
+            }
+        };
+
+        // The best cycle one search has seen: closed by the edge last->source (directed) or last-closing (undirected)
+        struct CycleCandidate {
+            long long length = Algorithms::UNREACHABLE;
+            size_t source = 0;
+            size_t last = 0;
+            size_t closing = 0;
+        };
+
+        /*
+        Shortest cycle search from one source, shared by girth and shortestCycle. Unweighted searches use a FIFO queue
+        (BFS), weighted ones a binary heap (Dijkstra). Directed: a cycle through the source is closed by an edge back
+        to it. Undirected: any edge between two settled vertices other than a tree edge closes a walk that contains
+        a cycle no heavier than it. The search stops once nothing it can still find beats the shared bound.
+        */
+        class CycleSearch {
+        public:
+            CycleSearch(const Adjacency &adj, bool undirected, bool weighted)
+                : adj(adj), undirected(undirected), weighted(weighted),
+                  distance(adj.vertexCount(), Algorithms::UNREACHABLE), parent(adj.vertexCount(), NO_PARENT),
+                  settled(adj.vertexCount(), 0) {}
+
+            CycleCandidate best;
+
+            void run(size_t source, atomic<long long> &bound) {
+                for (size_t v : touched) {
+                    distance[v] = Algorithms::UNREACHABLE;
+                    parent[v] = NO_PARENT;
+                    settled[v] = 0;
+                }
+                touched.clear();
+                fifo.clear();
+                heap = decltype(heap)();
+                reach(source, 0, NO_PARENT);
+
+                size_t head = 0;
+                while (weighted ? !heap.empty() : head < fifo.size()) {
+                    size_t u;
+                    if (weighted) {
+                        u = heap.top().second;
+                        long long d = heap.top().first;
+                        heap.pop();
+                        if (settled[u] || d != distance[u]) {
+                            continue;
+                        }
+                    } else {
+                        u = fifo[head++];
+                    }
+                    settled[u] = 1;
+                    long long d = distance[u];
+                    // Weights are at least 1: a directed cycle still to be found is longer than d, an undirected one at least 2d
+                    if ((undirected ? 2 * d : d + 1) >= bound.load(memory_order_relaxed)) {
+                        break;
+                    }
+                    for (size_t e = adj.offsets[u]; e < adj.offsets[u + 1]; e++) {
+                        size_t w = adj.targets[e];
+                        long long weight = weighted ? adj.weights[e] : 1;
+                        if (!undirected && w == source) {
+                            record(d + weight, source, u, w, bound);
+                        } else if (undirected && settled[w]) {
+                            if (w != parent[u]) {
+                                record(d + weight + distance[w], source, u, w, bound);
+                            }
+                        } else if (!settled[w] && d + weight < distance[w]) {
+                            reach(w, d + weight, u);
+                        }
+                    }
+                }
+            }
+
+            // The vertices of the best cycle, which is simple: a walk that repeats vertices would contain a lighter cycle
+            Path cycle() const {
+                Path result;
+                for (size_t x = best.last; x != NO_PARENT; x = parent[x]) {
+                    result.vertices.push_back(x);
+                }
+                reverse(result.vertices.begin(), result.vertices.end());
+                for (size_t x = best.closing; x != NO_PARENT && undirected; x = parent[x]) {
+                    result.vertices.push_back(x);
+                }
+                if (!undirected) {
+                    result.vertices.push_back(best.source);
+                }
+                result.weight = best.length;
+                return result;
+            }
+
+        private:
+            const Adjacency &adj;
+            bool undirected;
+            bool weighted;
+            vector<long long> distance;
+            vector<size_t> parent;
+            vector<char> settled;
+            vector<size_t> touched;
+            vector<size_t> fifo;
+            priority_queue<pair<long long, size_t>, vector<pair<long long, size_t>>, greater<pair<long long, size_t>>> heap;
+
+            void reach(size_t v, long long d, size_t from) {
+                if (distance[v] == Algorithms::UNREACHABLE) {
+                    touched.push_back(v);
+                    if (!weighted) {
+                        fifo.push_back(v);
+                    }
+                }
+                distance[v] = d;
+                parent[v] = from;
+                if (weighted) {
+                    heap.emplace(d, v);
+                }
+            }
+
+            void record(long long length, size_t source, size_t last, size_t closing, atomic<long long> &bound) {
+                if (length < best.length) {
+                    best.length = length;
+                    best.source = source;
+                    best.last = last;
+                    best.closing = closing;
+                    Parallel::atomicMin(bound, length);
+                }
+            }
+        };
+
+        // Shortest cycle over all sources on the worker threads, treating the graph as undirected if it is symmetric
+        CycleCandidate shortestCycleSearch(Graph &graph, bool weighted) {
+            const Adjacency &adj = graph.outEdges();
+            const Adjacency &in = graph.inEdges();
+            bool undirected = graph.isSymmetric();
+            size_t vertices = adj.vertexCount();
+
+            atomic<long long> bound(Algorithms::UNREACHABLE);
+            vector<CycleSearch> searches(Parallel::workers(), CycleSearch(adj, undirected, weighted));
+            Parallel::forEach(vertices, 16, [&](size_t worker, size_t begin, size_t end) {
+                for (size_t s = begin; s < end; s++) {
+                    size_t outDegree = adj.offsets[s + 1] - adj.offsets[s];
+                    size_t inDegree = in.offsets[s + 1] - in.offsets[s];
+                    // A vertex on a cycle has an edge in and an edge out, or two edges when undirected
+                    if (undirected ? outDegree >= 2 : (outDegree > 0 && inDegree > 0)) {
+                        searches[worker].run(s, bound);
+                    }
+                }
+            });
+
+            CycleCandidate best;
+            for (const CycleSearch &search : searches) {
+                if (search.best.length < best.length) {
+                    best = search.best;
+                }
+            }
+            return best;
+        }
+
+        // A bipartite graph with its left (partA) and right (partB) vertices renumbered, and the neighbours of every left vertex
+        struct BipartiteSides {
+            vector<size_t> left;
+            vector<size_t> right;
+            Adjacency adj;
+        };
+
+        BipartiteSides splitSides(const Graph &graph, const Bipartition &parts) {
+            if (!parts.bipartite) {
+                throw std::invalid_argument("Invalid graph: the graph is not bipartite.");
+            }
+            const Adjacency &out = graph.outEdges();
+            const Adjacency &in = graph.inEdges();
+            if (parts.partA.size() + parts.partB.size() != out.vertexCount()) {
+                throw std::invalid_argument("Invalid partition: it does not cover the graph.");
+            }
+            BipartiteSides sides;
+            sides.left = parts.partA;
+            sides.right = parts.partB;
+            vector<size_t> local(out.vertexCount());
+            for (size_t i = 0; i < sides.right.size(); i++) {
+                local[sides.right[i]] = i;
+            }
+            // Merge the sorted out- and in-rows, so an edge stored in both directions appears once (with the left->right weight)
+            sides.adj.offsets.assign(sides.left.size() + 1, 0);
+            for (size_t i = 0; i < sides.left.size(); i++) {
+                size_t u = sides.left[i];
+                size_t a = out.offsets[u], b = in.offsets[u];
+                while (a < out.offsets[u + 1] || b < in.offsets[u + 1]) {
+                    size_t v;
+                    int weight;
+                    if (b == in.offsets[u + 1] || (a < out.offsets[u + 1] && out.targets[a] < in.targets[b])) {
+                        v = out.targets[a];
+                        weight = out.weights[a++];
+                    } else if (a == out.offsets[u + 1] || in.targets[b] < out.targets[a]) {
+                        v = in.targets[b];
+                        weight = in.weights[b++];
+                    } else {
+                        v = out.targets[a];
+                        weight = out.weights[a++];
+                        b++;
+                    }
+                    sides.adj.targets.push_back(local[v]);
+                    sides.adj.weights.push_back(weight);
+                }
+                sides.adj.offsets[i + 1] = sides.adj.targets.size();
+            }
+            return sides;
+        }
+
+        /*
+        Hopcroft-Karp from any starting matching: a BFS from the free left vertices layers the graph by alternating
+        distance, then an iterative DFS finds vertex-disjoint shortest augmenting paths along the layers.
+        */
+        void hopcroftKarp(const BipartiteSides &sides, vector<size_t> &matchLeft, vector<size_t> &matchRight) {
+            const size_t NONE = Matching::UNMATCHED;
+            const Adjacency &adj = sides.adj;
+            size_t leftCount = sides.left.size();
+            vector<size_t> layer(leftCount);
+            vector<size_t> next(leftCount);
+            vector<size_t> queue, stack;
+            while (true) {
+                queue.clear();
+                for (size_t u = 0; u < leftCount; u++) {
+                    layer[u] = matchLeft[u] == NONE ? 0 : NONE;
+                    if (matchLeft[u] == NONE) {
+                        queue.push_back(u);
+                    }
+                }
+                bool augmentable = false;
+                for (size_t head = 0; head < queue.size(); head++) {
+                    size_t u = queue[head];
+                    for (size_t e = adj.offsets[u]; e < adj.offsets[u + 1]; e++) {
+                        size_t w = matchRight[adj.targets[e]];
+                        if (w == NONE) {
+                            augmentable = true;
+                        } else if (layer[w] == NONE) {
+                            layer[w] = layer[u] + 1;
+                            queue.push_back(w);
+                        }
+                    }
+                }
+                if (!augmentable) {
+                    return;
+                }
+
+                for (size_t u = 0; u < leftCount; u++) {
+                    next[u] = adj.offsets[u];
+                }
+                for (size_t root = 0; root < leftCount; root++) {
+                    if (matchLeft[root] != NONE) {
+                        continue;
+                    }
+                    stack.assign(1, root);
+                    while (!stack.empty()) {
+                        size_t u = stack.back();
+                        if (next[u] == adj.offsets[u + 1]) {
+                            // Dead end: drop u from the layering and move its parent past it
+                            layer[u] = NONE;
+                            stack.pop_back();
+                            if (!stack.empty()) {
+                                next[stack.back()]++;
+                            }
+                            continue;
+                        }
+                        size_t v = adj.targets[next[u]];
+                        size_t w = matchRight[v];
+                        if (w == NONE) {
+                            // Flip the path: every vertex on the stack takes the right vertex it is currently looking at
+                            for (size_t x : stack) {
+                                size_t y = adj.targets[next[x]];
+                                matchLeft[x] = y;
+                                matchRight[y] = x;
+                            }
+                            break;
+                        }
+                        if (layer[w] != NONE && layer[w] == layer[u] + 1) {
+                            stack.push_back(w);
+                        } else {
+                            next[u]++;
+                        }
+                    }
+                }
+            }
+        }
+
+        /*
+        Parallel push-relabel phase (Langguth, Kaya et al.): every free left vertex takes the neighbour with the lowest
+        label, raising it to the second lowest + 2, and evicts that neighbour's previous mate, which becomes free.
+        Vertices whose neighbours all reach the label limit give up; Hopcroft-Karp finishes the matching afterwards.
+        */
+        void pushRelabelMatching(const BipartiteSides &sides, vector<size_t> &matchRight) {
+            const size_t NONE = Matching::UNMATCHED;
+            const Adjacency &adj = sides.adj;
+            size_t rightCount = sides.right.size();
+            size_t limit = 2 * min(sides.left.size(), rightCount) + 2;
+            vector<atomic<size_t>> label(rightCount);
+            vector<atomic<size_t>> owner(rightCount);
+            for (size_t v = 0; v < rightCount; v++) {
+                label[v].store(0, memory_order_relaxed);
+                owner[v].store(NONE, memory_order_relaxed);
+            }
+
+            vector<size_t> active;
+            for (size_t u = 0; u < sides.left.size(); u++) {
+                if (adj.offsets[u + 1] > adj.offsets[u]) {
+                    active.push_back(u);
+                }
+            }
+            vector<vector<size_t>> evicted(Parallel::workers());
+            while (!active.empty()) {
+                Parallel::forEach(active.size(), 256, [&](size_t worker, size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; i++) {
+                        size_t u = active[i];
+                        size_t best = NONE, lowest = NONE, second = NONE;
+                        for (size_t e = adj.offsets[u]; e < adj.offsets[u + 1]; e++) {
+                            size_t l = label[adj.targets[e]].load(memory_order_relaxed);
+                            if (lowest == NONE || l < lowest) {
+                                second = lowest;
+                                lowest = l;
+                                best = adj.targets[e];
+                            } else if (second == NONE || l < second) {
+                                second = l;
+                            }
+                        }
+                        if (lowest >= limit) {
+                            continue;
+                        }
+                        label[best].store(second == NONE ? limit : second + 2, memory_order_relaxed);
+                        size_t previous = owner[best].exchange(u, memory_order_acq_rel);
+                        if (previous != NONE) {
+                            evicted[worker].push_back(previous);
+                        }
+                    }
+                });
+                active.clear();
+                for (auto &local : evicted) {
+                    active.insert(active.end(), local.begin(), local.end());
+                    local.clear();
+                }
+            }
+            for (size_t v = 0; v < rightCount; v++) {
+                matchRight[v] = owner[v].load(memory_order_relaxed);
+            }
+        }
+
+        // Split the graph for an assignment, checking that the smaller side can be fully assigned
+        BipartiteSides assignmentSides(Graph &graph, const Bipartition &parts) {
+            BipartiteSides sides = splitSides(graph, parts);
+            vector<size_t> matchLeft(sides.left.size(), Matching::UNMATCHED);
+            vector<size_t> matchRight(sides.right.size(), Matching::UNMATCHED);
+            hopcroftKarp(sides, matchLeft, matchRight);
+            size_t matched = 0;
+            for (size_t v : matchLeft) {
+                matched += v != Matching::UNMATCHED ? 1 : 0;
+            }
+            if (matched < min(sides.left.size(), sides.right.size())) {
+                throw std::invalid_argument("Invalid graph: the smaller side cannot be fully assigned.");
+            }
+            return sides;
+        }
+
+        // Map an assignment of left to right positions (anything >= the side sizes is padding) back to graph vertices
+        Assignment finishAssignment(const BipartiteSides &sides, const vector<size_t> &rightOf) {
+            Assignment result;
+            result.mate.assign(sides.left.size() + sides.right.size(), Matching::UNMATCHED);
+            for (size_t u = 0; u < sides.left.size(); u++) {
+                size_t v = rightOf[u];
+                if (v >= sides.right.size()) {
+                    continue;
+                }
+                for (size_t e = sides.adj.offsets[u]; e < sides.adj.offsets[u + 1]; e++) {
+                    if (sides.adj.targets[e] == v) {
+                        result.cost += sides.adj.weights[e];
+                    }
+                }
+                result.mate[sides.left[u]] = sides.right[v];
+                result.mate[sides.right[v]] = sides.left[u];
+                result.size++;
+            }
+            return result;
+        }
+
+        /*
+        Forward auction on the n x n problem made square with zero-benefit padding: left vertices (and padding rows) are
+        persons, right vertices (and padding columns) are objects. Benefits are costs negated and multiplied by n + 1,
+        so that epsilon = 1 in the last scaling phase is below 1/n of a unit of the original costs, which makes the
+        final assignment optimal. Every round, all unassigned persons bid in parallel; each object goes to its highest bid.
+        */
+        class Auction {
+        public:
+            explicit Auction(const BipartiteSides &sides)
+                : sides(sides), leftCount(sides.left.size()), rightCount(sides.right.size()),
+                  n(max(leftCount, rightCount)), price(n, 0), owner(n, Matching::UNMATCHED), objectOf(n, Matching::UNMATCHED), bestBid(n) {
+                long long largest = 1;
+                for (int weight : sides.adj.weights) {
+                    largest = max(largest, static_cast<long long>(weight < 0 ? -static_cast<long long>(weight) : weight));
+                }
+                scale = static_cast<long long>(n) + 1;
+                range = 2 * largest * scale;
+                for (auto &bid : bestBid) {
+                    bid.store(LLONG_MIN, memory_order_relaxed);
+                }
+            }
+
+            // Object of every person, after the epsilon-scaling phases
+            vector<size_t> run() {
+                long long epsilon = max(1LL, range / 10);
+                while (true) {
+                    phase(epsilon);
+                    if (epsilon == 1) {
+                        break;
+                    }
+                    epsilon = max(1LL, epsilon / 5);
+                }
+                return vector<size_t>(objectOf.begin(), objectOf.begin() + static_cast<ptrdiff_t>(leftCount));
+            }
+
+        private:
+            struct Bid {
+                size_t person;
+                size_t object;
+                long long amount;
+            };
+
+            const BipartiteSides &sides;
+            size_t leftCount;
+            size_t rightCount;
+            size_t n;
+            long long scale;
+            // Largest possible difference between two benefits
+            long long range;
+            vector<long long> price;
+            vector<size_t> owner;
+            vector<size_t> objectOf;
+            vector<atomic<long long>> bestBid;
+
+            // Run auction rounds from an empty assignment (prices are kept from the previous phase)
+            void phase(long long epsilon) {
+                fill(owner.begin(), owner.end(), Matching::UNMATCHED);
+                fill(objectOf.begin(), objectOf.end(), Matching::UNMATCHED);
+                vector<size_t> unassigned(n);
+                for (size_t i = 0; i < n; i++) {
+                    unassigned[i] = i;
+                }
+                vector<vector<Bid>> bids(Parallel::workers());
+                while (!unassigned.empty()) {
+                    Parallel::forEach(unassigned.size(), 16, [&](size_t worker, size_t begin, size_t end) {
+                        for (size_t k = begin; k < end; k++) {
+                            Bid bid = makeBid(unassigned[k], epsilon);
+                            bids[worker].push_back(bid);
+                            long long current = bestBid[bid.object].load(memory_order_relaxed);
+                            while (bid.amount > current &&
+                                   !bestBid[bid.object].compare_exchange_weak(current, bid.amount, memory_order_relaxed)) {
+                            }
+                        }
+                    });
+
+                    // Every object goes to the first of its highest bids, its previous owner is unassigned again
+                    unassigned.clear();
+                    for (auto &local : bids) {
+                        for (const Bid &bid : local) {
+                            if (bid.amount != bestBid[bid.object].load(memory_order_relaxed)) {
+                                unassigned.push_back(bid.person);
+                                continue;
+                            }
+                            bestBid[bid.object].store(LLONG_MIN, memory_order_relaxed);
+                            if (owner[bid.object] != Matching::UNMATCHED) {
+                                objectOf[owner[bid.object]] = Matching::UNMATCHED;
+                                unassigned.push_back(owner[bid.object]);
+                            }
+                            owner[bid.object] = bid.person;
+                            objectOf[bid.person] = bid.object;
+                            price[bid.object] = bid.amount;
+                        }
+                        local.clear();
+                    }
+                }
+            }
+
+            // Best and second best value (benefit - price) over the person's objects, and the bid that follows
+            Bid makeBid(size_t person, long long epsilon) const {
+                const long long NO_VALUE = LLONG_MIN;
+                long long best = NO_VALUE, second = NO_VALUE;
+                size_t bestObject = 0;
+                auto consider = [&](size_t object, long long benefit) {
+                    long long value = benefit - price[object];
+                    if (value > best) {
+                        second = best;
+                        best = value;
+                        bestObject = object;
+                    } else if (value > second) {
+                        second = value;
+                    }
+                };
+                if (person < leftCount) {
+                    for (size_t e = sides.adj.offsets[person]; e < sides.adj.offsets[person + 1]; e++) {
+                        consider(sides.adj.targets[e], -static_cast<long long>(sides.adj.weights[e]) * scale);
+                    }
+                    for (size_t object = rightCount; object < n; object++) {
+                        consider(object, 0);
+                    }
+                } else {
+                    for (size_t object = 0; object < n; object++) {
+                        consider(object, 0);
+                    }
+                }
+                // A person with a single object outbids anyone else for it
+                long long increment = second == NO_VALUE ? range : best - second;
+                return Bid{person, bestObject, price[bestObject] + increment + epsilon};
+            }
+        };
+
+        // Hungarian algorithm with row and column potentials, returns the column of every row of the n x n cost matrix
+        vector<size_t> hungarian(const vector<long long> &cost, size_t n) {
+            const long long INF = LLONG_MAX;
+            // 1-based columns, column 0 holds the row being inserted
+            vector<long long> rowPotential(n + 1, 0), columnPotential(n + 1, 0), slack(n + 1);
+            vector<size_t> rowOf(n + 1, 0), previous(n + 1, 0);
+            vector<char> used(n + 1);
+            for (size_t row = 1; row <= n; row++) {
+                rowOf[0] = row;
+                size_t column = 0;
+                fill(slack.begin(), slack.end(), INF);
+                fill(used.begin(), used.end(), 0);
+                // Grow the alternating tree from the new row until it reaches a free column
+                do {
+                    used[column] = 1;
+                    size_t current = rowOf[column];
+                    const long long *costs = &cost[(current - 1) * n];
+                    long long delta = INF;
+                    size_t next = 0;
+                    for (size_t j = 1; j <= n; j++) {
+                        if (used[j]) {
+                            continue;
+                        }
+                        long long reduced = costs[j - 1] - rowPotential[current] - columnPotential[j];
+                        if (reduced < slack[j]) {
+                            slack[j] = reduced;
+                            previous[j] = column;
+                        }
+                        if (slack[j] < delta) {
+                            delta = slack[j];
+                            next = j;
+                        }
+                    }
+                    for (size_t j = 0; j <= n; j++) {
+                        if (used[j]) {
+                            rowPotential[rowOf[j]] += delta;
+                            columnPotential[j] -= delta;
+                        } else {
+                            slack[j] -= delta;
+                        }
+                    }
+                    column = next;
+                } while (rowOf[column] != 0);
+                // Flip the augmenting path
+                do {
+                    size_t before = previous[column];
+                    rowOf[column] = rowOf[before];
+                    column = before;
+                } while (column != 0);
+            }
+            vector<size_t> columnOf(n);
+            for (size_t j = 1; j <= n; j++) {
+                columnOf[rowOf[j] - 1] = j - 1;
+            }
+            return columnOf;
+        }
+
+        // Map a local matching back to graph vertices and add the Koenig vertex cover
+        Matching finishMatching(const BipartiteSides &sides, const vector<size_t> &matchLeft, const vector<size_t> &matchRight) {
+            const size_t NONE = Matching::UNMATCHED;
+            const Adjacency &adj = sides.adj;
+            Matching result;
+            result.mate.assign(sides.left.size() + sides.right.size(), NONE);
+            for (size_t u = 0; u < sides.left.size(); u++) {
+                if (matchLeft[u] != NONE) {
+                    result.mate[sides.left[u]] = sides.right[matchLeft[u]];
+                    result.mate[sides.right[matchLeft[u]]] = sides.left[u];
+                    result.size++;
+                }
+            }
+
+            // Alternating search from the free left vertices: the cover is the unreached left and the reached right vertices
+            vector<char> leftReached(sides.left.size(), 0), rightReached(sides.right.size(), 0);
+            vector<size_t> pending;
+            for (size_t u = 0; u < sides.left.size(); u++) {
+                if (matchLeft[u] == NONE) {
+                    leftReached[u] = 1;
+                    pending.push_back(u);
+                }
+            }
+            while (!pending.empty()) {
+                size_t u = pending.back();
+                pending.pop_back();
+                for (size_t e = adj.offsets[u]; e < adj.offsets[u + 1]; e++) {
+                    size_t v = adj.targets[e];
+                    if (!rightReached[v]) {
+                        rightReached[v] = 1;
+                        size_t w = matchRight[v];
+                        if (w != NONE && !leftReached[w]) {
+                            leftReached[w] = 1;
+                            pending.push_back(w);
+                        }
+                    }
+                }
+            }
+            for (size_t u = 0; u < sides.left.size(); u++) {
+                if (!leftReached[u]) {
+                    result.vertexCover.push_back(sides.left[u]);
+                }
+            }
+            for (size_t v = 0; v < sides.right.size(); v++) {
+                if (rightReached[v]) {
+                    result.vertexCover.push_back(sides.right[v]);
+                }
+            }
+            sort(result.vertexCover.begin(), result.vertexCover.end());
+            return result;
+        }
+    }
+
+        /*
+        Algorithm we are using: Breadth-First Search (BFS), direction-optimizing (see breadthFirstSearch)
+
+            Step-by-Step:
+
+                1) Check the number of vertices. If 0, return true (an empty graph is considered connected).
+
+                2) Run the BFS engine from vertex 0 along the edge directions.
+
+                3) Check if all vertices were reached by comparing the reached count to the number of vertices.
+
+                -> Return true if all vertices were visited, otherwise false.
+        */
+
+        //Determine if a graph is connected (all vertices are reachable from any other vertex).
+        bool Algorithms::isConnected(Graph &graph) {
+        // Get the number of vertices in the graph
+        size_t vertices = graph.outEdges().vertexCount();
+
+        // If the graph is empty, it's considered connected
+        if (vertices == 0) {
+            return true;
+        }
+
+        // Check if we visited all the vertices
+        return breadthFirstSearch(graph, vector<size_t>(1, 0)).reached == vertices;
+    }
+
+    /*
+    Algorithm we are using: Single-source shortest paths (see singleSourceShortestPaths)
+
+        Step-by-Step:
+
+            1) Build the shortest path tree rooted at s, or reuse it from the graph's cache.
+
+            2) If a negative cycle is reachable from s, return "-1".
+
+            3) Otherwise, walk the predecessors back from v to s and return the path as a string.
+
+            -> Return the constructed path or "-1" if there is no path or a negative cycle is found.
+    */
+
+    // Find the shortest path from a source vertex s to a destination vertex v.
+    string Algorithms::shortestPath(Graph &graph, int s, int v) {
+        checkVertices(graph.outEdges(), s, v);
+        shared_ptr<const ShortestPathTree> tree = cachedTree(graph, static_cast<size_t>(s));
+        if (tree->negativeCycle) {
+            return "-1";
+        }
+        return tree->pathString(static_cast<size_t>(v));
+    }
+
+    /*
+    Algorithm we are using: Dijkstra when all weights are positive, otherwise the Bellman-Ford Algorithm
+
+        The weight statistics collected by loadGraph pick the algorithm:
+            - negative weights: Bellman-Ford.
+            - max weight <= DIAL_MAX_WEIGHT: Dial's bucket queue.
+            - larger weights: radix heap.
+
+        Bellman-Ford Step-by-Step:
+
+            1) Initialize distances from the source to all vertices as infinity, except the source itself (distance 0).
+
+            2) Relax the out-edges of queued vertices, disposing of the subtree of every improved vertex (see findNegativeCycle).
+
+            3) If an improved vertex is an ancestor of the edge's start, a negative cycle is reachable from the source.
+
+            Large graphs (at least PARALLEL_BELLMAN_FORD_MIN_EDGES edges) use parallelBellmanFord when more than one worker
+            is available.
+
+            -> Return the distance and predecessor of every vertex, flagged if a negative cycle was found.
+    */
+
+    // Compute the shortest path tree from source to every vertex.
+    ShortestPathTree Algorithms::singleSourceShortestPaths(Graph &graph, size_t source) {
+        if (source >= graph.outEdges().vertexCount()) {
+            throw std::invalid_argument("Invalid source: vertex does not exist.");
+        }
+        if (graph.shortestPathCache() != nullptr) {
+            return *cachedTree(graph, source);
+        }
+        return buildTree(graph, source);
+    }
+
+    /*
+    Algorithm we are using: Iterative Depth-First Search (DFS) with enter / exit events (see findCycle)
+
+        Step-by-Step:
+
+            1) A symmetric matrix is an undirected graph, where u->v and v->u are one edge and not a 2-cycle,
+               so it is searched with findUndirectedCycle. Any other graph is searched with findDirectedCycle.
+
+            2) If a cycle is found, print it.
+
+            -> Return "1" if a cycle is found, otherwise "0".
+    */
+
+    // Detect if there is any cycle in the graph.
+    string Algorithms::isContainsCycle(Graph &graph) {
+        vector<size_t> cycle;
+        if (graph.isSymmetric()) {
+            // Viewed as directed, any edge of a symmetric graph is a 2-cycle
+            graph.recordAcyclicity(graph.outEdges().edgeCount() == 0);
+            cycle = findUndirectedCycle(graph);
+        } else {
+            cycle = findDirectedCycle(graph);
+        }
+        if (cycle.empty()) {
+            return "0";
+        }
+        string result;
+        for (size_t i = 0; i < cycle.size(); i++) {
+            result += (i == 0 ? "" : "->") + to_string(cycle[i]);
+        }
+        cout << "The cycle is: " << result << endl;
+        return "1";
+    }
+
+    /*
+    Algorithm we are using: Iterative Depth-First Search (DFS) with back-edge detection
+
+        Step-by-Step:
+
+            1) Keep an explicit stack of (vertex, next edge) frames. Entering a vertex colors it gray and pushes a frame,
+               exiting it (all edges scanned) colors it black and pops the frame.
+
+            2) Scan one edge of the top frame at a time. A white target is entered with the current vertex as its parent.
+
+            3) A gray target is on the stack, so the edge closes a cycle: walk the parents back from the current vertex to it.
+
+            -> Return the cycle with its first vertex repeated at the end, or an empty list.
+    */
+
+    // Find a directed cycle in O(V + E).
+    vector<size_t> Algorithms::findDirectedCycle(Graph &graph) {
+        vector<size_t> cycle = findCycle(graph.outEdges(), nullptr);
+        graph.recordAcyclicity(cycle.empty());
+        return cycle;
+    }
+
+    /*
+    Algorithm we are using: Iterative Depth-First Search (DFS) with parent skipping
+
+        Step-by-Step:
+
+            1) Same search as findDirectedCycle, but the neighbours of a vertex are its out- and in-neighbours,
+               so edge directions are ignored.
+
+            2) The edge back to the parent is the tree edge itself and is skipped. Any other edge to a gray vertex
+               closes a cycle of at least three vertices.
+
+            -> Return the cycle with its first vertex repeated at the end, or an empty list.
+    */
+
+    // Find a cycle of the undirected graph in O(V + E).
+    vector<size_t> Algorithms::findUndirectedCycle(Graph &graph) {
+        return findCycle(graph.outEdges(), &graph.inEdges());
+    }
+
+    /*
+    Algorithm we are using: Johnson's elementary circuits algorithm, per strongly connected component
+
+        Step-by-Step:
+
+            1) Every cycle lies inside one strongly connected component, so split the graph into its components
+               (Tarjan) and drop the single vertices.
+
+            2) For every start vertex s of a component, keep the vertices >= s that are reachable from s and reach s back.
+               The cycles whose smallest vertex is s live there.
+
+            3) Run an iterative DFS from s. Closing an edge back to s reports the current path as a cycle.
+               Without a length bound, a vertex that led to no cycle stays blocked until one of its out-neighbours
+               is unblocked (Johnson), so no dead end is searched twice.
+               With a length bound, the DFS only extends the path to w if the path so far, plus the edge to w,
+               plus the shortest way from w back to s, fits in maxLength.
+
+            -> Return the number of cycles passed to visit. Memory stays O(V + E) whatever the number of cycles.
+    */
+
+    // Enumerate the elementary cycles in increasing order of their smallest vertex.
+    size_t Algorithms::elementaryCycles(Graph &graph, const function<bool(const vector<size_t> &)> &visit, size_t maxLength) {
+        size_t count = 0;
+        function<bool(const vector<size_t> &)> report = [&](const vector<size_t> &cycle) {
+            count++;
+            return visit(cycle);
+        };
+        vector<ComponentGraph> components = cyclicComponents(graph);
+        vector<size_t> order(components.size());
+        for (size_t c = 0; c < components.size(); c++) {
+            order[c] = c;
+        }
+        sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return components[a].vertices[0] < components[b].vertices[0];
+        });
+        CircuitSearch search(maxLength, report);
+        for (size_t c : order) {
+            for (size_t start = 0; start + 1 < components[c].vertices.size(); start++) {
+                if (!search.run(components[c], start)) {
+                    return count;
+                }
+            }
+        }
+        return count;
+    }
+
+    /*
+    Algorithm we are using: Johnson's elementary circuits algorithm, start vertices in parallel
+
+        Step-by-Step:
+
+            1) Split the graph into strongly connected components as in elementaryCycles.
+
+            2) The searches from different start vertices share nothing, so every (component, start vertex) pair is a task.
+               Worker threads take tasks from a shared counter, each with its own search workspace.
+
+            3) Reported cycles go through a mutex, so visit is never called concurrently. Once visit returns false,
+               the remaining tasks and searches stop.
+
+            -> Return the number of cycles passed to visit. visit must not throw.
+    */
+
+    // Enumerate the elementary cycles on all worker threads.
+    size_t Algorithms::parallelElementaryCycles(Graph &graph, const function<bool(const vector<size_t> &)> &visit, size_t maxLength) {
+        vector<ComponentGraph> components = cyclicComponents(graph);
+        vector<pair<size_t, size_t>> tasks;
+        for (size_t c = 0; c < components.size(); c++) {
+            for (size_t start = 0; start + 1 < components[c].vertices.size(); start++) {
+                tasks.emplace_back(c, start);
+            }
+        }
+
+        mutex reportLock;
+        atomic<bool> stopped(false);
+        size_t count = 0;
+        function<bool(const vector<size_t> &)> report = [&](const vector<size_t> &cycle) {
+            lock_guard<mutex> guard(reportLock);
+            if (stopped.load(memory_order_relaxed)) {
+                return false;
+            }
+            count++;
+            if (!visit(cycle)) {
+                stopped.store(true, memory_order_relaxed);
+                return false;
+            }
+            return true;
+        };
+
+        size_t workers = Parallel::workers();
+        vector<CircuitSearch> searches(workers, CircuitSearch(maxLength, report));
+        Parallel::forEach(tasks.size(), 1, [&](size_t worker, size_t begin, size_t end) {
+            for (size_t t = begin; t < end && !stopped.load(memory_order_relaxed); t++) {
+                searches[worker].run(components[tasks[t].first], tasks[t].second);
+            }
+        });
+        return count;
+    }
+
+    /*
+    Algorithm we are using: Howard's policy iteration per strongly connected component, with Karp's algorithm as fallback
+
+        Step-by-Step:
+
+            1) Split the graph into its strongly connected components with more than one vertex, every cycle lies in one.
+
+            2) Solve the components in parallel with Howard's policy iteration: every vertex follows one out-edge, the policy
+               is evaluated (mean of the cycle each vertex reaches, and a potential) and improved until it is stable.
+
+            3) If a component does not settle within |V| + 64 iterations, solve it exactly with Karp's O(VE) algorithm.
+
+            4) Compare the component results exactly, as weight / length fractions.
+
+            -> Return the cycle with the lowest mean weight (first vertex repeated at the end) and its total weight, so the
+               mean is weight / (vertices.size() - 1). Empty if the graph has no cycle.
+    */
+
+    // Cycle with the minimum mean edge weight.
+    Path Algorithms::minimumMeanCycle(Graph &graph) {
+        vector<ComponentGraph> components = cyclicComponents(graph);
+        vector<Path> cycles(components.size());
+        Parallel::forEach(components.size(), 1, [&](size_t, size_t begin, size_t end) {
+            for (size_t c = begin; c < end; c++) {
+                cycles[c] = howardMeanCycle(components[c], components[c].vertices.size() + 64);
+                if (cycles[c].vertices.empty()) {
+                    cycles[c] = karpMeanCycle(components[c]);
+                }
+            }
+        });
+
+        Path best;
+        for (const Path &cycle : cycles) {
+            if (best.vertices.empty() || lowerMean(cycle, best)) {
+                best = cycle;
+            }
+        }
+        graph.recordAcyclicity(best.vertices.empty());
+        return best;
+    }
+
+    /*
+    Algorithm we are using: Breadth-First Search (BFS) from every vertex, in parallel with a shared bound
+
+        Step-by-Step:
+
+            1) A symmetric graph is undirected, any other graph is directed (as in isContainsCycle).
+
+            2) Worker threads take source vertices from a shared counter and run a BFS from each. Directed: an edge back to
+               the source closes a cycle through it. Undirected: an edge between two reached vertices that is not a tree edge
+               closes a cycle of at most dist(u) + 1 + dist(w) edges.
+
+            3) Every cycle found lowers a shared atomic bound. A BFS stops as soon as its radius means it can no longer beat
+               the bound, so once a short cycle is known most searches end after a few levels.
+
+            -> Return the fewest edges on any cycle, or UNREACHABLE if the graph has no cycle.
+    */
+
+    // Girth of the graph (length of its shortest cycle in edges).
+    long long Algorithms::girth(Graph &graph) {
+        return shortestCycleSearch(graph, false).length;
+    }
+
+    /*
+    Algorithm we are using: Dijkstra from every vertex, in parallel with a shared bound
+
+        Step-by-Step:
+
+            1) Same search as girth with a binary heap instead of a FIFO queue, so distances are edge weights.
+               Weights must be non-negative.
+
+            2) A search stops once the popped distance d can no longer beat the bound (d + 1 directed, 2d undirected).
+
+            3) Search the best source once more to recover the cycle from its shortest path tree.
+
+            -> Return the lightest cycle (vertices, first one repeated at the end, and total weight). Empty if there is none.
+    */
+
+    // Lightest cycle of the graph.
+    Path Algorithms::shortestCycle(Graph &graph) {
+        checkNonNegative(graph);
+        CycleCandidate best = shortestCycleSearch(graph, true);
+        if (best.length == UNREACHABLE) {
+            return Path();
+        }
+        // Search the winning source again to recover the parents
+        CycleSearch search(graph.outEdges(), graph.isSymmetric(), true);
+        atomic<long long> bound(UNREACHABLE);
+        search.run(best.source, bound);
+        return search.cycle();
+    }
+
+    /*
+    Algorithm we are using: Kahn's algorithm
+
+        Step-by-Step:
+
+            1) Count the in-edges of every vertex and queue the vertices that have none.
+
+            2) Take the next vertex from the queue and append it to the order. Removing its out-edges may leave
+               some targets without in-edges, queue them too.
+
+            3) If some vertices were never queued, they lie on or behind a directed cycle.
+
+            -> Return the order (every edge goes from an earlier to a later vertex). Throws if the graph has a cycle.
+    */
+
+    // Topological order in O(V + E).
+    vector<size_t> Algorithms::topologicalSort(Graph &graph) {
+        vector<size_t> order;
+        if (!acyclicOrder(graph, order)) {
+            throw std::invalid_argument("Invalid graph: the graph contains a cycle.");
+        }
+        return order;
+    }
+
+    /*
+    Algorithm we are using: Level-synchronous Kahn's algorithm
+
+        Step-by-Step:
+
+            1) Count the in-edges of every vertex in parallel. The vertices without in-edges are level 0.
+
+            2) Process a whole level at once on the worker threads: every out-edge atomically decrements its target's count,
+               and the thread that brings it to zero adds the target to the next level.
+
+            3) Sort each level so the result does not depend on thread timing, and append it to the order.
+
+            -> Return the order level by level. Throws if the graph has a cycle.
+    */
+
+    // Topological order computed level by level on all worker threads.
+    vector<size_t> Algorithms::parallelTopologicalSort(Graph &graph) {
+        const Adjacency &out = graph.outEdges();
+        const Adjacency &in = graph.inEdges();
+        size_t vertices = out.vertexCount();
+        vector<atomic<size_t>> remaining(vertices);
+        Parallel::forEach(vertices, 4096, [&](size_t, size_t begin, size_t end) {
+            for (size_t v = begin; v < end; v++) {
+                remaining[v].store(in.offsets[v + 1] - in.offsets[v], memory_order_relaxed);
+            }
+        });
+
+        vector<size_t> order;
+        order.reserve(vertices);
+        for (size_t v = 0; v < vertices; v++) {
+            if (in.offsets[v + 1] == in.offsets[v]) {
+                order.push_back(v);
+            }
+        }
+        vector<vector<size_t>> found(Parallel::workers());
+        size_t levelBegin = 0;
+        while (levelBegin < order.size()) {
+            size_t levelEnd = order.size();
+            Parallel::forEach(levelEnd - levelBegin, 64, [&](size_t worker, size_t begin, size_t end) {
+                for (size_t i = levelBegin + begin; i < levelBegin + end; i++) {
+                    size_t u = order[i];
+                    for (size_t e = out.offsets[u]; e < out.offsets[u + 1]; e++) {
+                        if (remaining[out.targets[e]].fetch_sub(1, memory_order_acq_rel) == 1) {
+                            found[worker].push_back(out.targets[e]);
+                        }
+                    }
+                }
+            });
+            for (auto &local : found) {
+                order.insert(order.end(), local.begin(), local.end());
+                local.clear();
+            }
+            sort(order.begin() + static_cast<ptrdiff_t>(levelEnd), order.end());
+            levelBegin = levelEnd;
+        }
+
+        graph.recordAcyclicity(order.size() == vertices);
+        if (order.size() != vertices) {
+            throw std::invalid_argument("Invalid graph: the graph contains a cycle.");
+        }
+        return order;
+    }
+
+    /*
+    Algorithm we are using: Relaxation in topological order
+
+        Step-by-Step:
+
+            1) Compute a topological order (throws if the graph has a cycle).
+
+            2) Visit the vertices in that order starting from the source. Every path into a vertex comes from earlier vertices,
+               so its distance is final when it is visited: relax its out-edges once.
+
+            -> Return the ShortestPathTree. Negative weights are fine, O(V + E).
+    */
+
+    // Shortest paths from source in a directed acyclic graph.
+    ShortestPathTree Algorithms::dagShortestPaths(Graph &graph, size_t source) {
+        return dagPaths(graph, source, false);
+    }
+
+    // Longest (heaviest) paths from source in a directed acyclic graph, the same relaxation keeping the larger distance.
+    ShortestPathTree Algorithms::dagLongestPaths(Graph &graph, size_t source) {
+        return dagPaths(graph, source, true);
+    }
+
+    /*
+    Algorithm we are using: Parallel two-coloring (see bipartition)
+
+        Step-by-Step:
+
+            1) Color the graph with bipartition.
+
+            2) If it found an odd cycle, the graph is not bipartite.
+
+            -> Return "0" if the graph is not bipartite, otherwise return the partitions as a string.
+    */
+
+    //  Determine if the graph is bipartite (can be colored with two colors such that no two adjacent vertices share the same color).
+     string Algorithms::isBipartite(Graph &graph) {
+        Bipartition result = bipartition(graph);
+        if (!result.bipartite) {
+            return "0"; // Graph is not bipartite
+        }
+
+        // Print partitions
+        string output = "The graph is bipartite: A={";
+        for (size_t i = 0; i < result.partA.size(); ++i) {
+            output += to_string(result.partA[i]);
+            if (i < result.partA.size() - 1) {
+                output += ", ";
+            }
+        }
+        output += "}, B={";
+        for (size_t i = 0; i < result.partB.size(); ++i) {
+            output += to_string(result.partB[i]);
+            if (i < result.partB.size() - 1) {
+                output += ", ";
+            }
+        }
+        output += "}";
+        return output;
+
+    }
+
+    /*
+    Algorithm we are using: Level-synchronous parallel Breadth-First Search (BFS) two-coloring (see breadthFirstSearch)
+
+        Step-by-Step:
+
+            1) Find the connected components (ignoring edge directions) in parallel and take the smallest vertex of each as a BFS source.
+
+            2) Run one BFS from all sources at once over the undirected graph, so every component is colored concurrently.
+               A vertex gets color 0 on even levels and 1 on odd ones.
+
+            3) Scan the edges in parallel for one that joins two vertices with the same color. Blocks stop as soon as a
+               conflict with a smaller vertex is known, so the reported edge is always the one with the smallest endpoint.
+
+            4) For a conflicting edge u-w, walk both endpoints up the BFS tree to their common ancestor. The two tree paths
+               have the same parity, so with the edge they form an odd cycle.
+
+            -> Return the partitions, or the odd cycle if the graph is not bipartite.
+    */
+
+    // Two-color the graph or find an odd cycle.
+    Bipartition Algorithms::bipartition(Graph &graph) {
+        const Adjacency &adj = graph.outEdges();
+        size_t vertices = adj.vertexCount();
+        Bipartition result;
+        if (vertices == 0) {
+            return result; // empty graph is Bipartite
+        }
+
+        // The first vertex of every component, in order of the component labels
+        Components components = parallelConnectedComponents(graph);
+        vector<size_t> sources;
+        for (size_t v = 0; v < vertices; ++v) {
+            if (components.component[v] == sources.size()) {
+                sources.push_back(v);
+            }
+        }
+        BreadthFirstTree tree = breadthFirstSearch(graph, sources, true);
+
+        vector<char> color(vertices);
+        Parallel::forEach(vertices, 4096, [&](size_t, size_t begin, size_t end) {
+            for (size_t v = begin; v < end; ++v) {
+                color[v] = static_cast<char>(tree.hops[v] % 2);
+            }
+        });
+
+        const long long NO_CONFLICT = LLONG_MAX;
+        atomic<long long> conflictVertex(NO_CONFLICT);
+        vector<size_t> conflictTarget(vertices);
+        Parallel::forEach(vertices, 1024, [&](size_t, size_t begin, size_t end) {
+            for (size_t u = begin; u < end && static_cast<long long>(u) < conflictVertex.load(memory_order_relaxed); ++u) {
+                for (size_t e = adj.offsets[u]; e < adj.offsets[u + 1]; ++e) {
+                    if (color[adj.targets[e]] == color[u]) {
+                        conflictTarget[u] = adj.targets[e];
+                        Parallel::atomicMin(conflictVertex, static_cast<long long>(u));
+                        break;
+                    }
+                }
+            }
+        });
+
+        if (conflictVertex.load() != NO_CONFLICT) {
+            result.bipartite = false;
+            size_t u = static_cast<size_t>(conflictVertex.load());
+            size_t w = conflictTarget[u];
+            // Climb to the common ancestor: u's side in order, w's side reversed
+            vector<size_t> fromU, fromW;
+            while (u != w) {
+                if (tree.hops[u] >= tree.hops[w]) {
+                    fromU.push_back(u);
+                    u = tree.parent[u];
+                } else {
+                    fromW.push_back(w);
+                    w = tree.parent[w];
+                }
+            }
+            result.oddCycle = fromU;
+            result.oddCycle.push_back(u);
+            result.oddCycle.insert(result.oddCycle.end(), fromW.rbegin(), fromW.rend());
+            result.oddCycle.push_back(result.oddCycle.front());
+            return result;
+        }
+
+        for (size_t i = 0; i < vertices; ++i) {
+            if (color[i] == 0) {
+                result.partA.push_back(i);
+            } else {
+                result.partB.push_back(i);
+            }
+        }
+        return result;
+    }
+
+    /*
+    Algorithm we are using: Hopcroft-Karp
+
+        Step-by-Step:
+
+            1) Split the vertices into the two sides of the bipartition (edge directions are ignored).
+
+            2) Phase: BFS from all free left vertices along alternating paths (any edge left to right, matching edges
+               right to left) to find the length of the shortest augmenting path.
+
+            3) Iterative DFS from every free left vertex along the BFS layers. Each augmenting path found is flipped, and
+               dead ends are dropped from the layering, so one phase takes O(E) and finds a maximal set of disjoint paths.
+
+            4) Repeat until no augmenting path exists. There are O(sqrt(V)) phases.
+
+            5) Koenig: the left vertices not reachable from a free left vertex by an alternating path, plus the right ones
+               that are, cover every edge and are as many as the matching edges.
+
+            -> Return the mate of every vertex, the matching size and the minimum vertex cover.
+    */
+
+    // Maximum bipartite matching.
+    Matching Algorithms::maximumMatching(Graph &graph) {
+        return maximumMatching(graph, bipartition(graph));
+    }
+
+    Matching Algorithms::maximumMatching(Graph &graph, const Bipartition &parts) {
+        BipartiteSides sides = splitSides(graph, parts);
+        vector<size_t> matchLeft(sides.left.size(), Matching::UNMATCHED);
+        vector<size_t> matchRight(sides.right.size(), Matching::UNMATCHED);
+        hopcroftKarp(sides, matchLeft, matchRight);
+        return finishMatching(sides, matchLeft, matchRight);
+    }
+
+    /*
+    Algorithm we are using: Parallel push-relabel, finished with Hopcroft-Karp
+
+        Step-by-Step:
+
+            1) Split the vertices into the two sides of the bipartition. Every right vertex starts with label 0.
+
+            2) Process all free left vertices in parallel rounds. A free vertex scans its neighbours, claims the one with
+               the lowest label with an atomic exchange and raises that label to the second lowest + 2 (double push).
+               The vertex it evicts is free again in the next round.
+
+            3) Labels only grow, so every vertex eventually gets matched or sees only labels at the limit and gives up.
+
+            4) Run Hopcroft-Karp from the matching found: it only has the few remaining augmenting paths left to find,
+               and makes the result maximum.
+
+            -> Return the mate of every vertex, the matching size and the minimum vertex cover.
+    */
+
+    // Maximum bipartite matching on all worker threads.
+    Matching Algorithms::parallelMaximumMatching(Graph &graph) {
+        return parallelMaximumMatching(graph, bipartition(graph));
+    }
+
+    Matching Algorithms::parallelMaximumMatching(Graph &graph, const Bipartition &parts) {
+        BipartiteSides sides = splitSides(graph, parts);
+        vector<size_t> matchLeft(sides.left.size(), Matching::UNMATCHED);
+        vector<size_t> matchRight(sides.right.size(), Matching::UNMATCHED);
+        pushRelabelMatching(sides, matchRight);
+        for (size_t v = 0; v < matchRight.size(); v++) {
+            if (matchRight[v] != Matching::UNMATCHED) {
+                matchLeft[matchRight[v]] = v;
+            }
+        }
+        hopcroftKarp(sides, matchLeft, matchRight);
+        return finishMatching(sides, matchLeft, matchRight);
+    }
+
+    /*
+    Algorithm we are using: Hungarian algorithm (Kuhn-Munkres) with potentials
+
+        Step-by-Step:
+
+            1) Split the graph into its two sides and check with Hopcroft-Karp that the smaller side can be fully assigned
+
+            2) Build a flat n x n cost matrix (n = size of the larger side): the weight of every edge, a cost larger than any
+               complete assignment for missing edges, and 0 for the padding rows or columns of the smaller side
+
+            3) Insert the rows one at a time, growing shortest augmenting paths over reduced costs and updating the potentials
+
+            -> Return the pairs that are real edges and the sum of their weights
+    */
+    // Function to find a minimum cost assignment
+    Assignment Algorithms::minimumCostAssignment(Graph &graph) {
+        return minimumCostAssignment(graph, bipartition(graph));
+    }
+
+    Assignment Algorithms::minimumCostAssignment(Graph &graph, const Bipartition &parts) {
+        BipartiteSides sides = assignmentSides(graph, parts);
+        size_t n = max(sides.left.size(), sides.right.size());
+        long long largest = 0;
+        for (int weight : sides.adj.weights) {
+            largest = max(largest, static_cast<long long>(weight < 0 ? -static_cast<long long>(weight) : weight));
+        }
+        // Any assignment using a missing edge costs more than every assignment that does not
+        long long missing = 2 * largest * static_cast<long long>(n) + 1;
+        vector<long long> cost(n * n, 0);
+        for (size_t u = 0; u < sides.left.size(); u++) {
+            long long *row = &cost[u * n];
+            fill(row, row + sides.right.size(), missing);
+            for (size_t e = sides.adj.offsets[u]; e < sides.adj.offsets[u + 1]; e++) {
+                row[sides.adj.targets[e]] = sides.adj.weights[e];
+            }
+        }
+        return finishAssignment(sides, hungarian(cost, n));
+    }
+
+    /*
+    Algorithm we are using: Auction algorithm (Bertsekas) with epsilon scaling
+
+        Step-by-Step:
+
+            1) Split the graph and check that the smaller side can be fully assigned, as for the Hungarian algorithm
+
+            2) Pad the smaller side with vertices that have benefit 0 for everything, and scale the negated costs by n + 1
+
+            3) Every round, all unassigned persons bid in parallel for their best object, raising its price by the
+               difference to their second best value plus epsilon; each object takes its highest bid
+
+            4) Repeat with epsilon divided by 5 (keeping the prices) until a phase with epsilon = 1 finishes
+
+            -> Return the pairs that are real edges and the sum of their weights
+    */
+    // Function to find a minimum cost assignment with the parallel auction algorithm
+    Assignment Algorithms::parallelMinimumCostAssignment(Graph &graph) {
+        return parallelMinimumCostAssignment(graph, bipartition(graph));
+    }
+
+    Assignment Algorithms::parallelMinimumCostAssignment(Graph &graph, const Bipartition &parts) {
+        BipartiteSides sides = assignmentSides(graph, parts);
+        return finishAssignment(sides, Auction(sides).run());
+    }
+
+    /*
+    Algorithm we are using: Bellman-Ford with frontier rounds, in parallel
+
+        Step-by-Step:
+
+            1) Start with the source as the only vertex of the frontier.
+
+            2) Every round, relax the out-edges of the frontier on the worker threads, lowering distances with an atomic
+               min. The vertices whose distance dropped (each collected once) form the next frontier.
+
+            3) Without a negative cycle the frontier is empty after at most |V| - 1 rounds. If it is still not empty at
+               round |V|, a negative cycle is reachable from the source.
 
-            Step-by-Step:
+            4) Set the parents with a BFS over the tight edges (dist[u] + w == dist[v]) from the source. Several tight
+               edges can reach a vertex with the same distance, and they race when relaxed in parallel, so the BFS
+               picks one deterministically.
 
-                1) Check the number of vertices. If 0, return true (an empty graph is considered connected).
+            -> Return the distance and predecessor of every vertex, flagged if a negative cycle was found.
+    */
 
-                2) Initialize a set to track visited vertices and a stack for DFS traversal.
+    // Shortest path tree for any weights, relaxing on the worker threads.
+    ShortestPathTree Algorithms::parallelBellmanFord(Graph &graph, size_t source) {
+        const Adjacency &adj = graph.outEdges();
+        if (source >= adj.vertexCount()) {
+            throw std::invalid_argument("Invalid source: vertex does not exist.");
+        }
+        ShortestPathTree tree = emptyTree(adj.vertexCount(), source);
+        tree.negativeCycle = !frontierBellmanFord(adj, source, tree.distance, tree.parent);
+        return tree;
+    }
 
-                3) Start DFS from vertex 0, marking visited vertices and pushing adjacent vertices onto the stack.
+    /*
+    Algorithm we are using: Bellman-Ford-Tarjan from a virtual source (see findNegativeCycle)
 
-                4) After traversal, check if all vertices were visited by comparing the size of the visited set to the number of vertices.
+        Step-by-Step:
 
-                -> Return true if all vertices were visited, otherwise false.
-        */
+            1) Search the whole graph for a negative cycle, as if a new vertex had a zero-weight edge to every vertex.
 
-        //Determine if a graph is connected (all vertices are reachable from any other vertex).
-        bool Algorithms::isConnected(Graph &graph) {
-        // Get the number of vertices in the graph
-        size_t vertices = graph.matrix.size();
+            2) Write the cycle as its vertices separated by spaces, the first one repeated at the end.
 
-        // If the graph is empty, it's considered connected
-        if (vertices == 0) {
-            return true;
+            -> Return "Negative cycle detected: " followed by the cycle if one is found, otherwise return "No negative cycle detected".
+    */
+
+    //  Detect if there is a negative weight cycle in the graph.
+    string Algorithms::negativeCycle(Graph &graph) {
+        Path cycle = findNegativeCycle(graph);
+        if (cycle.vertices.empty()) {
+            return "No negative cycle detected";
+        }
+        string cycleString;
+        for (size_t v : cycle.vertices) {
+            cycleString += (cycleString.empty() ? "" : " ") + to_string(v);
         }
+        return "Negative cycle detected: " + cycleString;
+    }
 
-        // Set to store visited vertices
-        std::set<size_t> visited_vertices;
+    /*
+    Algorithm we are using: Bellman-Ford-Tarjan (FIFO Bellman-Ford with subtree disposal)
 
-        // Stack for DFS traversal
-        std::stack<size_t> stack;
+        Step-by-Step:
 
-        // Start DFS traversal from vertex 0
-        stack.push(0);
+            1) Keep the shortest path tree as a preorder list with depths, and a FIFO queue of vertices to scan.
 
-        // Perform DFS traversal
-        while (!stack.empty()) {
-            size_t vertex = stack.top();
-            stack.pop();
+            2) When the edge u->w lowers the distance of w, walk the subtree of w: it is out of date, so its vertices leave
+               the tree and are not scanned until they improve again. Then w becomes a child of u.
 
-            // If the vertex has not been visited yet
-            if (visited_vertices.find(vertex) == visited_vertices.end()) {
-                // Mark the vertex as visited
-                visited_vertices.insert(vertex);
+            3) If u is found in the subtree of w, the tree path w..u plus u->w is a negative cycle.
 
-                // Visit adjacent vertices
-                for (size_t adj = 0; adj < vertices; adj++) {
-                    if (graph.matrix[vertex][adj] != 0) {
-                        stack.push(adj);
-                    }
-                }
-            }
+            -> Return the cycle (first vertex repeated at the end) and its total weight, or an empty path if no negative
+               cycle is reachable from the source.
+    */
+
+    // Negative cycle reachable from source.
+    Path Algorithms::findNegativeCycle(Graph &graph, size_t source) {
+        const Adjacency &adj = graph.outEdges();
+        if (source >= adj.vertexCount()) {
+            throw std::invalid_argument("Invalid source: vertex does not exist.");
         }
+        vector<long long> dist(adj.vertexCount(), UNREACHABLE);
+        vector<size_t> parent(adj.vertexCount(), ShortestPathTree::NO_PARENT);
+        Path cycle;
+        cycle.vertices = tarjanBellmanFord(adj, source, dist, parent);
+        if (!cycle.vertices.empty()) {
+            cycle.weight = cycleWeight(graph, cycle.vertices);
+            graph.recordAcyclicity(false);
+        }
+        return cycle;
+    }
 
-        // Check if we visited all the vertices
-        return visited_vertices.size() == vertices;
+    /*
+    Algorithm we are using: Bellman-Ford-Tarjan from a virtual source
+
+        Step-by-Step:
+
+            1) Start with every vertex at distance 0 as a child of a virtual root, which is the same as adding a vertex with
+               a zero-weight edge to every vertex, but without copying the graph.
+
+            2) Run the subtree disposal search of findNegativeCycle(graph, source) from there.
+
+            -> Return the first negative cycle found anywhere in the graph and its total weight, or an empty path if the
+               graph has none.
+    */
+
+    // Negative cycle anywhere in the graph.
+    Path Algorithms::findNegativeCycle(Graph &graph) {
+        vector<Path> cycles = disjointNegativeCycles(graph, 1);
+        return cycles.empty() ? Path() : cycles.front();
     }
 
     /*
-    Algorithm we are using: Bellman-Ford Algorithm
+    Algorithm we are using: Bellman-Ford-Tarjan from a virtual source, repeated
 
         Step-by-Step:
 
-            1) Initialize distances from the source to all vertices as infinity, except the source itself (distance 0).
+            1) Search the whole graph for a negative cycle from the virtual source.
+
+            2) Remove the vertices of the cycle found (edges into them are ignored) and search the rest again from scratch,
+               since the distances of the last run may come from walks through the removed cycle.
+
+            3) Stop when no negative cycle is left, or after limit cycles (0 means no limit).
+
+            -> Return the vertex-disjoint negative cycles found, each with its total weight.
+    */
+
+    // Vertex-disjoint negative cycles of the graph.
+    vector<Path> Algorithms::disjointNegativeCycles(Graph &graph, size_t limit) {
+        const Adjacency &adj = graph.outEdges();
+        size_t vertices = adj.vertexCount();
+        vector<char> removed(vertices, 0);
+        vector<long long> dist(vertices);
+        vector<size_t> parent(vertices);
+        vector<Path> cycles;
+        while (limit == 0 || cycles.size() < limit) {
+            fill(dist.begin(), dist.end(), UNREACHABLE);
+            fill(parent.begin(), parent.end(), ShortestPathTree::NO_PARENT);
+            Path cycle;
+            cycle.vertices = tarjanBellmanFord(adj, ShortestPathTree::NO_PARENT, dist, parent, &removed);
+            if (cycle.vertices.empty()) {
+                break;
+            }
+            cycle.weight = cycleWeight(graph, cycle.vertices);
+            for (size_t v : cycle.vertices) {
+                removed[v] = 1;
+            }
+            cycles.push_back(cycle);
+        }
+        if (!cycles.empty()) {
+            graph.recordAcyclicity(false);
+        }
+        return cycles;
+    }
+
+    /*
+    Algorithm we are using: Delta-Stepping (Meyer & Sanders)
+
+        Step-by-Step:
+
+            1) Split the distance axis into buckets of width delta. Edges with weight <= delta are "light", the rest are "heavy".
 
-            2) Use a loop to relax edges |V| - 1 times, where |V| is the number of vertices. Update distances if a shorter path is found.
+            2) Take the smallest non-empty bucket. Relax the light edges of all its vertices in parallel, lowering distances with an atomic min.
+               Vertices whose distance dropped into the same bucket are processed again until the bucket stays empty.
 
-            3) After relaxation, check for negative weight cycles by verifying if any distance can still be minimized.
+            3) Every vertex removed from the bucket now has its final distance, so relax their heavy edges once, again in parallel.
 
-            4) If a negative cycle is found, return "-1".
+            4) Repeat with the next non-empty bucket until none are left.
 
-            5) Otherwise, construct the path from the destination to the source using predecessors and return it as a string.
+            -> Return the distance of every vertex from the source (UNREACHABLE if there is no path).
 
-            -> Return the constructed path or "-1" if a negative cycle is found.
+        When delta is 0 it is tuned from the graph: max weight / average out-degree, so a bucket holds roughly one "hop" of work.
+        delta = 1 on unit weights is a parallel BFS, a huge delta is a parallel Bellman-Ford.
     */
 
-    // Find the shortest path from a source vertex s to a destination vertex v.
-    string Algorithms::shortestPath(Graph &graph, int s, int v) {
-        size_t numOfVertices = graph.matrix.size();
-        vector<int> dist(graph.matrix.size(), INT_MAX); // Initialize distances to infinity
-        dist[static_cast<size_t>(s)] = 0; // Initialize distances of s to 0
-        vector<size_t> pai(numOfVertices, static_cast<size_t>(-1));
+    // Find the distances from source to every vertex, using all worker threads.
+    vector<long long> Algorithms::deltaStepping(Graph &graph, size_t source, long long delta) {
+        const Adjacency &adj = graph.outEdges();
+        size_t vertices = adj.vertexCount();
+        if (source >= vertices) {
+            throw std::invalid_argument("Invalid source: vertex does not exist.");
+        }
+        if (delta < 0) {
+            throw std::invalid_argument("Invalid delta: bucket width must be positive.");
+        }
 
-        for (size_t i = 1; i <= numOfVertices - 1; i++) { // Relax n - 1 times
-            for (size_t j = 0; j < numOfVertices; j++) {
-                for (size_t k = 0; k < numOfVertices; k++) {
-                    if (graph.matrix[j][k] != 0 && dist[j] != INT_MAX && dist[j] + graph.matrix[j][k] < dist[k]) {
-                        dist[k] = dist[j] + graph.matrix[j][k];
-                        pai[k] = j;
-                    }
-                }
+        long long maxWeight = 0;
+        for (int weight : adj.weights) {
+            if (weight < 0) {
+                throw std::invalid_argument("Delta-stepping requires non-negative edge weights.");
             }
+            maxWeight = max(maxWeight, static_cast<long long>(weight));
+        }
+        if (delta == 0) {
+            long long averageDegree = static_cast<long long>(adj.edgeCount() / vertices);
+            delta = max(1LL, maxWeight / max(1LL, averageDegree));
         }
 
-        for (size_t i = 0; i < numOfVertices; i++) { // Check if there is negative cycles
-            for (size_t j = 0; j < numOfVertices; j++) {
-                if (graph.matrix[i][j] != 0 && dist[i] != INT_MAX && dist[i] + graph.matrix[i][j] < dist[j]) {
-                    return "-1";
+        vector<atomic<long long>> dist(vertices);
+        for (auto &d : dist) {
+            d.store(UNREACHABLE, memory_order_relaxed);
+        }
+        dist[source].store(0, memory_order_relaxed);
+
+        map<long long, vector<size_t>> buckets; // bucket index -> vertices (may hold stale duplicates)
+        buckets[0].push_back(source);
+        vector<long long> relaxedAt(vertices, UNREACHABLE); // distance at which the light edges were last relaxed
+        vector<char> settled(vertices, 0);
+        vector<vector<size_t>> improved(Parallel::workers());
+        const size_t grain = 256;
+
+        // Relax the light or heavy out-edges of every vertex in the list, collecting the vertices whose distance dropped
+        auto relax = [&](const vector<size_t> &list, bool light) {
+            Parallel::forEach(list.size(), grain, [&](size_t worker, size_t begin, size_t end) {
+                vector<size_t> &local = improved[worker];
+                for (size_t i = begin; i < end; i++) {
+                    size_t u = list[i];
+                    long long du = dist[u].load(memory_order_relaxed);
+                    for (size_t e = adj.offsets[u]; e < adj.offsets[u + 1]; e++) {
+                        long long weight = adj.weights[e];
+                        if ((weight <= delta) == light && Parallel::atomicMin(dist[adj.targets[e]], du + weight)) {
+                            local.push_back(adj.targets[e]);
+                        }
+                    }
+                }
+            });
+            for (auto &local : improved) {
+                for (size_t v : local) {
+                    buckets[dist[v].load(memory_order_relaxed) / delta].push_back(v);
+                }
+                local.clear();
+            }
+        };
+
+        while (!buckets.empty()) {
+            long long current = buckets.begin()->first;
+            vector<size_t> removed; // vertices settled by this bucket
+            while (!buckets.empty() && buckets.begin()->first == current) {
+                vector<size_t> frontier = std::move(buckets.begin()->second);
+                buckets.erase(buckets.begin());
+
+                // Drop stale entries: vertices that moved to another bucket or were already relaxed at this distance
+                size_t kept = 0;
+                for (size_t v : frontier) {
+                    long long dv = dist[v].load(memory_order_relaxed);
+                    if (dv / delta == current && dv < relaxedAt[v]) {
+                        relaxedAt[v] = dv;
+                        frontier[kept++] = v;
+                        if (!settled[v]) {
+                            settled[v] = 1;
+                            removed.push_back(v);
+                        }
+                    }
                 }
+                frontier.resize(kept);
+                relax(frontier, true);
             }
+            relax(removed, false);
         }
 
-        // Print the distances
-        size_t i = static_cast<size_t>(v); // Start from destination
-        string path = to_string(i);
-        while (i != static_cast<size_t>(s) && pai[i] != static_cast<size_t>(-1)) { // Traverse back until source is reached
-            path = to_string(pai[i]) + "->" + path;
-            i = pai[i];
+        vector<long long> result(vertices);
+        for (size_t v = 0; v < vertices; v++) {
+            result[v] = dist[v].load(memory_order_relaxed);
         }
-        if (i != static_cast<size_t>(s)) // If source is not reached
-            return "-1";
-        else
-            return path;
+        return result;
+    }
+
+    // Find the shortest path from s to v with Dial's algorithm (O(E + V * maxWeight)).
+    string Algorithms::shortestPathDial(Graph &graph, int s, int v) {
+        const Adjacency &adj = graph.outEdges();
+        checkVertices(adj, s, v);
+        checkNonNegative(graph);
+        ShortestPathTree tree;
+        tree.source = static_cast<size_t>(s);
+        tree.distance.assign(adj.vertexCount(), UNREACHABLE);
+        tree.parent.assign(adj.vertexCount(), NO_PARENT);
+        dialDijkstra(adj, static_cast<size_t>(s), graph.weightStatistics().maxWeight, tree.distance, tree.parent);
+        return tree.pathString(static_cast<size_t>(v));
+    }
+
+    // Find the shortest path from s to v with a radix heap (O(E + V log C), C = max weight).
+    string Algorithms::shortestPathRadixHeap(Graph &graph, int s, int v) {
+        const Adjacency &adj = graph.outEdges();
+        checkVertices(adj, s, v);
+        checkNonNegative(graph);
+        ShortestPathTree tree;
+        tree.source = static_cast<size_t>(s);
+        tree.distance.assign(adj.vertexCount(), UNREACHABLE);
+        tree.parent.assign(adj.vertexCount(), NO_PARENT);
+        radixHeapDijkstra(adj, static_cast<size_t>(s), tree.distance, tree.parent);
+        return tree.pathString(static_cast<size_t>(v));
     }
 
     /*
-    Algorithm we are using: Depth-First Search (DFS) with color marking
+    Algorithm we are using: Yen's k shortest loopless paths, with Lawler's and Hershberger-style shortcuts
 
         Step-by-Step:
 
-            1) Initialize color arrays (white for unvisited, gray for currently visiting, black for fully visited) and parent arrays.
+            1) Run one Dijkstra backwards from the target. Its distances h(v) and its tree (next hop towards the target)
+               are shared by every spur search below.
+
+            2) The first path is the tree path from the source.
+
+            3) For the last accepted path P, and for every spur vertex P[i] at or after the index where P deviated from
+               its parent path (Lawler), search for the best path from P[i] to the target that avoids P[0..i-1] and the
+               edges P[i]->next taken by accepted paths sharing the root P[0..i].
 
-            2) Perform DFS from each vertex. If a gray vertex is encountered during DFS, a cycle is detected.
+            4) Each spur search is A* with h as the potential. Deleting vertices and edges only lengthens distances, so h stays
+               consistent, and as soon as a popped vertex's tree path to the target avoids the blocked vertices the search stops:
+               that tree path is already optimal.
 
-            3) If a cycle is found, construct the cycle path and print it.
+            5) Root + spur paths go into a candidate set, and the cheapest candidate becomes the next accepted path.
 
-            4) Return "1" if a cycle is found, otherwise "0".
+            -> Return up to k paths, cheapest first.
     */
 
-    // Detect if there is any cycle in the graph.
-    string Algorithms::isContainsCycle(Graph &graph) {
-        size_t vertices = graph.matrix.size();
-        if (vertices == 0) {
-            return "0"; // No vertices in an empty graph
-        }
-
-        vector<int> color(vertices, 0); // 0 for white, 1 for gray, 2 for black
-        vector<int> parent(vertices, -1); // Store parent vertices
-        bool cycleFound = false;
-
-        // Perform DFS from each vertex
-        for (size_t start = 0; start < vertices; ++start) {
-            if (color[start] == 0) { // If vertex is not visited
-                stack<size_t> dfsStack;
-                dfsStack.push(start); // Start DFS from this vertex
-
-                while (!dfsStack.empty()) {
-                    size_t u = dfsStack.top();
-                    dfsStack.pop();
-
-                    if (color[u] == 1) { // If vertex is currently being visited (gray)
-                        // Cycle detected
-                        cycleFound = true;
-                        // Print the cycle
-                        string cycle;
-                        size_t current = u;
-                        do {
-                            cycle += to_string(current) + "->";
-                            current = static_cast<size_t>(parent[current]);
-                        } while (current != start);
-                        cycle += to_string(start);
-                        cout << start << "->" << cycle << endl;
-                        break;
-                    }
+    // Find the k cheapest simple paths from source to target.
+    vector<Path> Algorithms::kShortestPaths(Graph &graph, size_t source, size_t target, size_t k) {
+        const Adjacency &out = graph.outEdges();
+        const Adjacency &in = graph.inEdges();
+        size_t vertices = out.vertexCount();
+        if (source >= vertices || target >= vertices) {
+            throw std::invalid_argument("Invalid vertex: vertex does not exist.");
+        }
+        checkNonNegative(graph);
 
-                    if (color[u] == 2) // If vertex is already visited (black), skip
-                        continue;
+        vector<Path> accepted;
+        if (k == 0) {
+            return accepted;
+        }
 
-                    color[u] = 1; // Mark current vertex as gray
+        // Shared reverse shortest path tree towards the target
+        vector<long long> toTarget(vertices, UNREACHABLE);
+        vector<size_t> nextHop(vertices, NO_PARENT);
+        radixHeapDijkstra(in, target, toTarget, nextHop);
+        if (toTarget[source] == UNREACHABLE) {
+            return accepted;
+        }
+
+        auto treePath = [&](size_t from, Path &path) {
+            for (size_t v = from; v != target; v = nextHop[v]) {
+                path.vertices.push_back(nextHop[v]);
+                path.weight += graph.matrix[v][nextHop[v]];
+            }
+        };
+
+        Path first;
+        first.vertices.push_back(source);
+        treePath(source, first);
+        accepted.push_back(first);
+
+        // Candidates ordered by (weight, vertices), each mapped to the index where it deviates from its parent path
+        map<pair<long long, vector<size_t>>, size_t> candidates;
+        vector<size_t> deviations(1, 0);
+
+        vector<char> blockedVertex(vertices, 0);
+        vector<long long> cost(vertices, UNREACHABLE);
+        vector<size_t> parent(vertices, NO_PARENT);
+        vector<size_t> touched;
+
+        while (accepted.size() < k) {
+            const vector<size_t> last = accepted.back().vertices;
+            long long rootWeight = 0;
+            for (size_t i = 0; i < deviations.back(); i++) {
+                blockedVertex[last[i]] = 1;
+                rootWeight += graph.matrix[last[i]][last[i + 1]];
+            }
+
+            for (size_t i = deviations.back(); i + 1 < last.size(); i++) {
+                size_t spur = last[i];
+
+                // Edges leaving the spur vertex that accepted paths with the same root already use
+                set<size_t> blockedNext;
+                for (const Path &path : accepted) {
+                    if (path.vertices.size() > i + 1 && equal(last.begin(), last.begin() + static_cast<ptrdiff_t>(i) + 1, path.vertices.begin())) {
+                        blockedNext.insert(path.vertices[i + 1]);
+                    }
+                }
 
-                    // Explore neighbors of u
-                    for (size_t v = 0; v < vertices; ++v) {
-                        if (graph.matrix[u][v] != 0) { // There's an edge from u to v
-                            if (color[v] == 0) { // If v is white (not visited)
-                                parent[v] = static_cast<int>(u); // Set parent of v as u
-                                dfsStack.push(v);
+                // A* from the spur vertex with the exact reverse distances as the potential
+                typedef pair<long long, size_t> Entry;
+                priority_queue<Entry, vector<Entry>, greater<Entry>> open;
+                cost[spur] = 0;
+                touched.push_back(spur);
+                open.push(Entry(toTarget[spur], spur));
+                size_t reached = NO_PARENT;
+                while (!open.empty()) {
+                    Entry top = open.top();
+                    open.pop();
+                    size_t u = top.second;
+                    if (top.first != cost[u] + toTarget[u]) {
+                        continue;
+                    }
+                    // Stop once the shared tree path from u is usable: it is the cheapest completion
+                    bool treeUsable = true;
+                    for (size_t v = u; v != target && treeUsable; v = nextHop[v]) {
+                        treeUsable = !blockedVertex[nextHop[v]] && !(v == spur && blockedNext.count(nextHop[v]) > 0);
+                    }
+                    if (treeUsable) {
+                        reached = u;
+                        break;
+                    }
+                    for (size_t e = out.offsets[u]; e < out.offsets[u + 1]; e++) {
+                        size_t t = out.targets[e];
+                        if (blockedVertex[t] || toTarget[t] == UNREACHABLE || (u == spur && blockedNext.count(t) > 0)) {
+                            continue;
+                        }
+                        long long candidate = cost[u] + out.weights[e];
+                        if (candidate < cost[t]) {
+                            if (cost[t] == UNREACHABLE) {
+                                touched.push_back(t);
                             }
+                            cost[t] = candidate;
+                            parent[t] = u;
+                            open.push(Entry(candidate + toTarget[t], t));
                         }
                     }
                 }
+
+                if (reached != NO_PARENT) {
+                    Path candidate;
+                    candidate.vertices.assign(last.begin(), last.begin() + static_cast<ptrdiff_t>(i));
+                    vector<size_t> spurPath;
+                    for (size_t v = reached; v != spur; v = parent[v]) {
+                        spurPath.push_back(v);
+                    }
+                    spurPath.push_back(spur);
+                    candidate.vertices.insert(candidate.vertices.end(), spurPath.rbegin(), spurPath.rend());
+                    candidate.weight = rootWeight + cost[reached];
+                    treePath(reached, candidate);
+                    candidates.insert(make_pair(make_pair(candidate.weight, candidate.vertices), i));
+                }
+
+                for (size_t v : touched) {
+                    cost[v] = UNREACHABLE;
+                    parent[v] = NO_PARENT;
+                }
+                touched.clear();
+
+                // The spur vertex joins the root for the next spur index
+                blockedVertex[spur] = 1;
+                rootWeight += graph.matrix[spur][last[i + 1]];
+            }
+            for (size_t v : last) {
+                blockedVertex[v] = 0;
             }
 
-            if (cycleFound)
+            if (candidates.empty()) {
                 break;
+            }
+            auto best = candidates.begin();
+            Path next;
+            next.weight = best->first.first;
+            next.vertices = best->first.second;
+            accepted.push_back(next);
+            deviations.push_back(best->second);
+            candidates.erase(best);
+        }
+        return accepted;
+    }
+
+    bool ShortestPathTree::hasPath(size_t v) const {
+        return !negativeCycle && distance[v] != Algorithms::UNREACHABLE;
+    }
+
+    // Vertices from the source to v, empty if v is not reachable
+    vector<size_t> ShortestPathTree::pathTo(size_t v) const {
+        vector<size_t> path;
+        if (!hasPath(v)) {
+            return path;
+        }
+        for (size_t i = v; i != source; i = parent[i]) {
+            path.push_back(i);
+        }
+        path.push_back(source);
+        reverse(path.begin(), path.end());
+        return path;
+    }
+
+    // The path to v in the same "s->...->v" format as shortestPath, or "-1"
+    string ShortestPathTree::pathString(size_t v) const {
+        if (!hasPath(v)) {
+            return "-1";
+        }
+        string path = to_string(v);
+        for (size_t i = v; i != source; i = parent[i]) {
+            path = to_string(parent[i]) + "->" + path;
         }
+        return path;
+    }
+
+    size_t ShortestPathTree::memoryBytes() const {
+        return sizeof(ShortestPathTree) + distance.capacity() * sizeof(long long) + parent.capacity() * sizeof(size_t);
+    }
 
-        return cycleFound ? "1" : "0"; // Return 1 if cycle found, else 0
+    // Check connectivity in the requested sense.
+    bool Algorithms::isConnected(Graph &graph, Connectivity mode) {
+        if (graph.outEdges().vertexCount() == 0) {
+            return true;
+        }
+        switch (mode) {
+            case Connectivity::Strong:
+                return stronglyConnectedComponents(graph).count == 1;
+            case Connectivity::Weak:
+                return parallelConnectedComponents(graph).count == 1;
+            default:
+                return isConnected(graph);
+        }
     }
 
     /*
-    Algorithm we are using: Breadth-First Search (BFS)
+    Algorithm we are using: Tarjan's strongly connected components, with an explicit stack instead of recursion
 
         Step-by-Step:
 
-            1) Initialize color arrays and a queue for BFS.
+            1) Give every vertex a discovery index when the DFS first reaches it and push it on the component stack.
 
-            2) Start BFS from each uncolored vertex, assigning alternating colors to adjacent vertices.
+            2) Each DFS frame remembers the next out-edge to look at, so a vertex is resumed where it left off.
+               Tree edges push a new frame, edges to vertices still on the component stack lower the low-link.
 
-            3) If an adjacent vertex has the same color, the graph is not bipartite.
+            3) When a vertex finishes with low-link == index, it is the root of a component: pop the component stack down to it.
 
-            4) If BFS completes without conflicts, construct and return the partitions.
+            4) The finished vertex passes its low-link to the frame below it.
 
-            -> Return "0" if the graph is not bipartite, otherwise return the partitions as a string.
+            -> Return the component label of every vertex.
     */
 
-    //  Determine if the graph is bipartite (can be colored with two colors such that no two adjacent vertices share the same color).
-     string Algorithms::isBipartite(Graph &graph) {
-        size_t vertices = graph.matrix.size();
-        if (vertices == 0) {
-            return "The graph is bipartite: A={}, B={}"; // empty graph is Bipartite
+    // Find the strongly connected components of the graph.
+    Components Algorithms::stronglyConnectedComponents(Graph &graph) {
+        const Adjacency &adj = graph.outEdges();
+        size_t vertices = adj.vertexCount();
+        vector<size_t> index(vertices, NO_PARENT);
+        vector<size_t> low(vertices, 0);
+        vector<char> onStack(vertices, 0);
+        vector<size_t> labels(vertices, NO_PARENT);
+        vector<size_t> componentStack;
+        vector<pair<size_t, size_t>> frames; // (vertex, next edge)
+        size_t counter = 0;
+        size_t components = 0;
+
+        for (size_t root = 0; root < vertices; root++) {
+            if (index[root] != NO_PARENT) {
+                continue;
+            }
+            index[root] = low[root] = counter++;
+            componentStack.push_back(root);
+            onStack[root] = 1;
+            frames.push_back(make_pair(root, adj.offsets[root]));
+
+            while (!frames.empty()) {
+                size_t v = frames.back().first;
+                size_t &edge = frames.back().second;
+                if (edge < adj.offsets[v + 1]) {
+                    size_t w = adj.targets[edge++];
+                    if (index[w] == NO_PARENT) {
+                        index[w] = low[w] = counter++;
+                        componentStack.push_back(w);
+                        onStack[w] = 1;
+                        frames.push_back(make_pair(w, adj.offsets[w]));
+                    } else if (onStack[w]) {
+                        low[v] = min(low[v], index[w]);
+                    }
+                    continue;
+                }
+
+                frames.pop_back();
+                if (low[v] == index[v]) {
+                    size_t w;
+                    do {
+                        w = componentStack.back();
+                        componentStack.pop_back();
+                        onStack[w] = 0;
+                        labels[w] = components;
+                    } while (w != v);
+                    components++;
+                }
+                if (!frames.empty()) {
+                    size_t parent = frames.back().first;
+                    low[parent] = min(low[parent], low[v]);
+                }
+            }
         }
+        return normalizeComponents(labels);
+    }
 
-        vector<int> color(vertices, -1); // Assign colors to vertices, -1 means not colored yet
-        queue<size_t> queue;
+    /*
+    Algorithm we are using: Forward-Backward with trimming and coloring (Fleischer et al., Orzan; as in Hong et al.)
 
-        for (size_t start = 0; start < vertices; ++start) {
-            if (color[start] != -1) {
-                continue; // Vertex already colored
-            }
+        Step-by-Step:
 
-            color[start] = 0; // Color the start vertex with 0 (first partition)
-            queue.push(start);
+            1) Trim: vertices with no live in-edges or no live out-edges are components on their own. Remove them repeatedly.
 
-            while (!queue.empty()) {
-                size_t vertex = queue.front();
-                queue.pop();
+            2) Forward-backward: from a high-degree pivot, compute the vertices it reaches and the vertices reaching it
+               with parallel BFS. Their intersection is the pivot's component (usually the giant one). Remove it.
 
-                for (size_t adj = 0; adj < vertices; ++adj) {
-                    if (graph.matrix[vertex][adj] != 0) {
-                        if (color[adj] == -1) {
-                            color[adj] = 1 - color[vertex]; // Assign the opposite color to adjacent vertex
-                            queue.push(adj);
-                        } else if (color[adj] == color[vertex]) {
-                            return "0"; // Graph is not bipartite
-                        }
-                    }
+            3) Coloring, until no vertex is left:
+               a) Every vertex starts with its own id as color. Propagate the largest color along out-edges in parallel until stable.
+               b) Each vertex whose color is its own id roots one component: the vertices of that color that reach it backwards.
+                  Those backward searches touch disjoint color classes, so they run in parallel. Remove the found components.
+
+            -> Return the component label of every vertex.
+    */
+
+    // Find the strongly connected components of the graph using all worker threads.
+    Components Algorithms::parallelStronglyConnectedComponents(Graph &graph) {
+        const Adjacency &out = graph.outEdges();
+        const Adjacency &in = graph.inEdges();
+        size_t vertices = out.vertexCount();
+        vector<size_t> labels(vertices, NO_PARENT);
+        vector<char> alive(vertices, 1);
+        size_t remaining = vertices;
+        if (vertices == 0) {
+            return Components();
+        }
+
+        // 1) Trim
+        vector<size_t> inDegree(vertices), outDegree(vertices);
+        vector<size_t> trimQueue;
+        for (size_t v = 0; v < vertices; v++) {
+            inDegree[v] = in.offsets[v + 1] - in.offsets[v];
+            outDegree[v] = out.offsets[v + 1] - out.offsets[v];
+            if (inDegree[v] == 0 || outDegree[v] == 0) {
+                trimQueue.push_back(v);
+                alive[v] = 0;
+            }
+        }
+        while (!trimQueue.empty()) {
+            size_t v = trimQueue.back();
+            trimQueue.pop_back();
+            labels[v] = v;
+            remaining--;
+            for (size_t e = out.offsets[v]; e < out.offsets[v + 1]; e++) {
+                size_t t = out.targets[e];
+                if (alive[t] && --inDegree[t] == 0) {
+                    alive[t] = 0;
+                    trimQueue.push_back(t);
+                }
+            }
+            for (size_t e = in.offsets[v]; e < in.offsets[v + 1]; e++) {
+                size_t t = in.targets[e];
+                if (alive[t] && --outDegree[t] == 0) {
+                    alive[t] = 0;
+                    trimQueue.push_back(t);
                 }
             }
         }
 
-        // Graph is bipartite, print partitions
-        vector<size_t> partitionA, partitionB;
-        for (size_t i = 0; i < vertices; ++i) {
-            if (color[i] == 0) {
-                partitionA.push_back(i);
-            } else {
-                partitionB.push_back(i);
+        // 2) Forward-backward from the live vertex with the largest degree product
+        if (remaining > 0) {
+            size_t pivot = NO_PARENT;
+            for (size_t v = 0; v < vertices; v++) {
+                if (alive[v] && (pivot == NO_PARENT || inDegree[v] * outDegree[v] > inDegree[pivot] * outDegree[pivot])) {
+                    pivot = v;
+                }
+            }
+            vector<char> forward = parallelReach(out, pivot, alive);
+            vector<char> backward = parallelReach(in, pivot, alive);
+            for (size_t v = 0; v < vertices; v++) {
+                if (forward[v] && backward[v]) {
+                    labels[v] = pivot;
+                    alive[v] = 0;
+                    remaining--;
+                }
             }
         }
 
-        // Print partitions
-        string output = "The graph is bipartite: A={";
-        for (size_t i = 0; i < partitionA.size(); ++i) {
-            output += to_string(partitionA[i]);
-            if (i < partitionA.size() - 1) {
-                output += ", ";
+        // 3) Coloring
+        vector<atomic<size_t>> color(vertices);
+        vector<atomic<char>> queued(vertices);
+        vector<vector<size_t>> changed(Parallel::workers());
+        while (remaining > 0) {
+            vector<size_t> active;
+            for (size_t v = 0; v < vertices; v++) {
+                color[v].store(v, memory_order_relaxed);
+                queued[v].store(0, memory_order_relaxed);
+                if (alive[v]) {
+                    active.push_back(v);
+                }
             }
-        }
-        output += "}, B={";
-        for (size_t i = 0; i < partitionB.size(); ++i) {
-            output += to_string(partitionB[i]);
-            if (i < partitionB.size() - 1) {
-                output += ", ";
+            while (!active.empty()) {
+                Parallel::forEach(active.size(), 64, [&](size_t worker, size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; i++) {
+                        size_t u = active[i];
+                        queued[u].store(0, memory_order_relaxed);
+                        size_t c = color[u].load(memory_order_relaxed);
+                        for (size_t e = out.offsets[u]; e < out.offsets[u + 1]; e++) {
+                            size_t t = out.targets[e];
+                            if (alive[t] && atomicMax(color[t], c) && queued[t].exchange(1) == 0) {
+                                changed[worker].push_back(t);
+                            }
+                        }
+                    }
+                });
+                active.clear();
+                for (auto &local : changed) {
+                    active.insert(active.end(), local.begin(), local.end());
+                    local.clear();
+                }
+            }
+
+            vector<size_t> roots;
+            for (size_t v = 0; v < vertices; v++) {
+                if (alive[v] && color[v].load(memory_order_relaxed) == v) {
+                    roots.push_back(v);
+                }
+            }
+            Parallel::forEach(roots.size(), 1, [&](size_t, size_t begin, size_t end) {
+                vector<size_t> stack;
+                for (size_t i = begin; i < end; i++) {
+                    size_t root = roots[i];
+                    labels[root] = root;
+                    stack.push_back(root);
+                    while (!stack.empty()) {
+                        size_t u = stack.back();
+                        stack.pop_back();
+                        for (size_t e = in.offsets[u]; e < in.offsets[u + 1]; e++) {
+                            size_t t = in.targets[e];
+                            if (alive[t] && color[t].load(memory_order_relaxed) == root && labels[t] == NO_PARENT) {
+                                labels[t] = root;
+                                stack.push_back(t);
+                            }
+                        }
+                    }
+                }
+            });
+            for (size_t v = 0; v < vertices; v++) {
+                if (alive[v] && labels[v] != NO_PARENT) {
+                    alive[v] = 0;
+                    remaining--;
+                }
             }
         }
-        output += "}";
-        return output;
+        return normalizeComponents(labels);
+    }
+
+    /*
+    Algorithm we are using: Union-Find
+
+        Step-by-Step:
+
+            1) Start with every vertex in its own set.
+
+            2) Unite the endpoints of every edge, ignoring its direction.
+
+            -> Return the set of every vertex as its component label.
+    */
 
+    // Find the weakly connected components of the graph.
+    Components Algorithms::weaklyConnectedComponents(Graph &graph) {
+        const Adjacency &adj = graph.outEdges();
+        size_t vertices = adj.vertexCount();
+        UnionFind sets(vertices);
+        for (size_t u = 0; u < vertices; u++) {
+            for (size_t e = adj.offsets[u]; e < adj.offsets[u + 1]; e++) {
+                sets.unite(u, adj.targets[e]);
+            }
+        }
+        vector<size_t> labels(vertices);
+        for (size_t v = 0; v < vertices; v++) {
+            labels[v] = sets.find(v);
+        }
+        return normalizeComponents(labels);
     }
 
     /*
-    Algorithm we are using: Bellman-Ford Algorithm
+    Algorithm we are using: Afforest (Sutton, Ben-Nun & Barak) over a lock-free union-find (Shiloach-Vishkin style hooking)
 
         Step-by-Step:
 
-            1) Initialize distances from a source vertex to all vertices as infinity, except the source itself (distance 0).
+            1) Every vertex starts as its own root. Linking hooks the larger root under the smaller with a CAS,
+               so roots only ever point to smaller ids and concurrent links cannot form a cycle.
+
+            2) Link every vertex to its first two out-neighbours in parallel, then compress. On real graphs this already
+               forms most of the giant component.
 
-            2) Use a loop to relax edges |V| - 1 times, updating distances if a shorter path is found.
+            3) Sample vertices to find the most frequent component, which is almost certainly the giant one.
 
-            3) After relaxation, check for negative weight cycles by verifying if any distance can still be minimized.
+            4) Link the remaining edges in parallel, but skip vertices already in the giant component. For asymmetric graphs
+               the in-edges of the other vertices are linked too, so edges pointing out of the giant component are not lost.
+               A symmetric graph skips them: every in-edge there is also an out-edge.
 
-            4) If a negative cycle is detected, trace back through predecessors to construct the cycle path and return it as a string.
+            5) Compress once more and number the components.
 
-            -> Return "Negative cycle detected" followed by the cycle path if a negative cycle is found, otherwise return "No negative cycle detected".
+            -> Return the component label and size of every component.
     */
 
-    //  Detect if there is a negative weight cycle in the graph.
-    string Algorithms::negativeCycle(Graph &graph) {
-    size_t vertices = graph.matrix.size(); // Use size_t instead of int for vertices
-    vector<int> distances(vertices, INT_MAX);
-    vector<int> predecessors(vertices, -1); // Store predecessors
+    // Find the weakly connected components of the graph using all worker threads.
+    Components Algorithms::parallelConnectedComponents(Graph &graph) {
+        const Adjacency &out = graph.outEdges();
+        // In a symmetric graph every in-edge is also an out-edge, so there is nothing extra to link
+        bool symmetric = graph.isSymmetric();
+        const Adjacency &in = symmetric ? out : graph.inEdges();
+        size_t vertices = out.vertexCount();
+        vector<atomic<size_t>> parent(vertices);
+        for (size_t v = 0; v < vertices; v++) {
+            parent[v].store(v, memory_order_relaxed);
+        }
+        const size_t neighbourRounds = 2;
+        const size_t grain = 1024;
+
+        for (size_t round = 0; round < neighbourRounds; round++) {
+            Parallel::forEach(vertices, grain, [&](size_t, size_t begin, size_t end) {
+                for (size_t u = begin; u < end; u++) {
+                    if (out.offsets[u] + round < out.offsets[u + 1]) {
+                        linkComponents(u, out.targets[out.offsets[u] + round], parent);
+                    }
+                }
+            });
+            compressComponents(parent);
+        }
 
-    distances[0] = 0;
+        // Most frequent root among a fixed pseudo-random sample
+        size_t giant = 0;
+        if (vertices > 0) {
+            map<size_t, size_t> frequency;
+            unsigned long long state = 88172645463325252ULL;
+            size_t bestCount = 0;
+            for (size_t i = 0; i < 1024; i++) {
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+                size_t root = parent[static_cast<size_t>(state % vertices)].load(memory_order_relaxed);
+                if (++frequency[root] > bestCount) {
+                    bestCount = frequency[root];
+                    giant = root;
+                }
+            }
+        }
 
-    // Relax edges |V| - 1 times
-    for (size_t i = 0; i < vertices - 1; ++i) {
-        for (size_t u = 0; u < vertices; ++u) {
-            for (size_t v = 0; v < vertices; ++v) {
-                if (graph.matrix[u][v] != 0 && distances[u] != INT_MAX && distances[u] + graph.matrix[u][v] < distances[v]) {
-                    distances[v] = distances[u] + graph.matrix[u][v];
-                    predecessors[v] = static_cast<int>(u); // Update predecessor
+        Parallel::forEach(vertices, grain, [&](size_t, size_t begin, size_t end) {
+            for (size_t u = begin; u < end; u++) {
+                if (parent[u].load(memory_order_relaxed) == giant) {
+                    continue;
+                }
+                for (size_t e = out.offsets[u] + neighbourRounds; e < out.offsets[u + 1]; e++) {
+                    linkComponents(u, out.targets[e], parent);
+                }
+                if (symmetric) {
+                    continue;
+                }
+                for (size_t e = in.offsets[u]; e < in.offsets[u + 1]; e++) {
+                    linkComponents(u, in.targets[e], parent);
                 }
             }
+        });
+        compressComponents(parent);
+
+        vector<size_t> labels(vertices);
+        for (size_t v = 0; v < vertices; v++) {
+            labels[v] = parent[v].load(memory_order_relaxed);
         }
+        return normalizeComponents(labels);
     }
 
-    // Check for negative cycles
-    for (size_t u = 0; u < vertices; ++u) {
-        for (size_t v = 0; v < vertices; ++v) {
-            if (graph.matrix[u][v] != 0 && distances[u] != INT_MAX && distances[u] + graph.matrix[u][v] < distances[v]) {
-                // Negative cycle detected
-                size_t vertexInCycle = u;
-                for (size_t i = 0; i < vertices; ++i) {
-                    vertexInCycle = static_cast<size_t>(predecessors[vertexInCycle]);
-                }
+    /*
+    Algorithm we are using: Direction-optimizing Breadth-First Search (Beamer, Asanovic & Patterson)
 
-                // Trace back to construct the cycle
-                vector<size_t> cycle;
-                size_t current = vertexInCycle;
-                do {
-                    cycle.push_back(current);
-                    current = static_cast<size_t>(predecessors[current]);
-                } while (current != vertexInCycle);
+        Step-by-Step:
+
+            1) Start with all sources in the frontier at level 0.
+
+            2) Top-down step (small frontiers): scan the out-edges of every frontier vertex in parallel and claim
+               unvisited neighbours with a CAS on their parent.
+
+            3) Bottom-up step (large frontiers): every unvisited vertex scans its in-edges in parallel and stops at the
+               first neighbour found in the frontier bitmap. On low-diameter graphs this skips most edge checks.
+
+            4) Switch to bottom-up when the frontier's edges exceed 1/14 of the unexplored edges, and back to top-down
+               when the frontier shrinks below 1/24 of the vertices.
+
+            -> Return the hop count, parent and source of every reached vertex.
+
+        With ignoreDirection every edge is followed both ways (out- and in-edges are merged in both steps).
+    */
+
+    // Breadth-first search from a set of sources.
+    BreadthFirstTree Algorithms::breadthFirstSearch(Graph &graph, const vector<size_t> &sources, bool ignoreDirection) {
+        const Adjacency &out = graph.outEdges();
+        const Adjacency &in = graph.inEdges();
+        size_t vertices = out.vertexCount();
+        const size_t UNVISITED = BreadthFirstTree::UNVISITED;
+        const size_t alpha = 14, beta = 24, grain = 256;
+
+        vector<atomic<size_t>> parent(vertices);
+        for (auto &p : parent) {
+            p.store(UNVISITED, memory_order_relaxed);
+        }
+        BreadthFirstTree tree;
+        tree.hops.assign(vertices, UNVISITED);
+        tree.root.assign(vertices, UNVISITED);
+
+        vector<size_t> frontier;
+        for (size_t s : sources) {
+            if (s >= vertices) {
+                throw std::invalid_argument("Invalid source: vertex does not exist.");
+            }
+            if (tree.hops[s] == UNVISITED) {
+                tree.hops[s] = 0;
+                tree.root[s] = s;
+                parent[s].store(s, memory_order_relaxed); // sources point to themselves while searching
+                frontier.push_back(s);
+            }
+        }
 
-                // Construct the cycle string
-                string cycleString;
-                for (size_t i = cycle.size() - 1; i >= 0; --i) {
-                    cycleString += to_string(cycle[i]) + " ";
+        size_t words = (vertices + 63) / 64;
+        vector<atomic<unsigned long long>> current(words), next(words);
+        vector<vector<size_t>> found(Parallel::workers());
+        size_t unexploredEdges = out.edgeCount() * (ignoreDirection ? 2 : 1) - degreeSum(out, in, ignoreDirection, frontier);
+        size_t frontierSize = frontier.size();
+        size_t reached = frontierSize;
+        bool bottomUp = false;
+
+        for (size_t level = 1; frontierSize > 0; level++) {
+            // Pick the direction for this level
+            if (!bottomUp) {
+                size_t frontierEdges = degreeSum(out, in, ignoreDirection, frontier);
+                if (frontierEdges > unexploredEdges / alpha && frontierSize > 64) {
+                    bottomUp = true;
+                    for (auto &word : current) {
+                        word.store(0, memory_order_relaxed);
+                    }
+                    for (size_t v : frontier) {
+                        current[v / 64].fetch_or(1ULL << (v % 64), memory_order_relaxed);
+                    }
                 }
-                cycleString += to_string(cycle[0]); // Close the cycle
+            } else if (frontierSize < vertices / beta) {
+                bottomUp = false;
+                frontier.clear();
+                for (size_t v = 0; v < vertices; v++) {
+                    if (current[v / 64].load(memory_order_relaxed) & (1ULL << (v % 64))) {
+                        frontier.push_back(v);
+                    }
+                }
+            }
 
-                return "Negative cycle detected: " + cycleString;
+            vector<size_t> counts(found.size(), 0);
+            if (bottomUp) {
+                for (auto &word : next) {
+                    word.store(0, memory_order_relaxed);
+                }
+                Parallel::forEach(vertices, 1024, [&](size_t worker, size_t begin, size_t end) {
+                    for (size_t v = begin; v < end; v++) {
+                        if (parent[v].load(memory_order_relaxed) != UNVISITED) {
+                            continue;
+                        }
+                        const Adjacency *sides[2] = {&in, &out};
+                        for (size_t side = 0; side < (ignoreDirection ? 2u : 1u); side++) {
+                            const Adjacency &adj = *sides[side];
+                            size_t e = adj.offsets[v];
+                            for (; e < adj.offsets[v + 1]; e++) {
+                                size_t u = adj.targets[e];
+                                if (current[u / 64].load(memory_order_relaxed) & (1ULL << (u % 64))) {
+                                    parent[v].store(u, memory_order_relaxed);
+                                    next[v / 64].fetch_or(1ULL << (v % 64), memory_order_relaxed);
+                                    counts[worker]++;
+                                    break;
+                                }
+                            }
+                            if (e < adj.offsets[v + 1]) {
+                                break;
+                            }
+                        }
+                    }
+                });
+                swap(current, next);
+                frontierSize = 0;
+                for (size_t count : counts) {
+                    frontierSize += count;
+                }
+                // Levels and roots follow the parents, which all belong to the previous level
+                vector<size_t> exploredEdges(found.size(), 0);
+                Parallel::forEach(vertices, 4096, [&](size_t worker, size_t begin, size_t end) {
+                    for (size_t v = begin; v < end; v++) {
+                        if (current[v / 64].load(memory_order_relaxed) & (1ULL << (v % 64))) {
+                            tree.hops[v] = level;
+                            tree.root[v] = tree.root[parent[v].load(memory_order_relaxed)];
+                            exploredEdges[worker] += out.offsets[v + 1] - out.offsets[v];
+                            if (ignoreDirection) {
+                                exploredEdges[worker] += in.offsets[v + 1] - in.offsets[v];
+                            }
+                        }
+                    }
+                });
+                for (size_t edges : exploredEdges) {
+                    unexploredEdges -= edges;
+                }
+            } else {
+                Parallel::forEach(frontier.size(), grain, [&](size_t worker, size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; i++) {
+                        size_t u = frontier[i];
+                        const Adjacency *sides[2] = {&out, &in};
+                        for (size_t side = 0; side < (ignoreDirection ? 2u : 1u); side++) {
+                            const Adjacency &adj = *sides[side];
+                            for (size_t e = adj.offsets[u]; e < adj.offsets[u + 1]; e++) {
+                                size_t t = adj.targets[e];
+                                size_t expected = UNVISITED;
+                                if (parent[t].load(memory_order_relaxed) == UNVISITED &&
+                                    parent[t].compare_exchange_strong(expected, u, memory_order_relaxed)) {
+                                    found[worker].push_back(t);
+                                }
+                            }
+                        }
+                    }
+                });
+                frontier.clear();
+                for (auto &local : found) {
+                    frontier.insert(frontier.end(), local.begin(), local.end());
+                    local.clear();
+                }
+                frontierSize = frontier.size();
+                for (size_t v : frontier) {
+                    tree.hops[v] = level;
+                    tree.root[v] = tree.root[parent[v].load(memory_order_relaxed)];
+                }
+                unexploredEdges -= degreeSum(out, in, ignoreDirection, frontier);
             }
+            reached += frontierSize;
         }
+
+        tree.parent.resize(vertices);
+        for (size_t v = 0; v < vertices; v++) {
+            size_t p = parent[v].load(memory_order_relaxed);
+            tree.parent[v] = p == v ? UNVISITED : p;
+        }
+        tree.reached = reached;
+        return tree;
+    }
+
+    // Hop distance from source to every vertex.
+    vector<size_t> Algorithms::hopDistances(Graph &graph, size_t source) {
+        return breadthFirstSearch(graph, vector<size_t>(1, source)).hops;
     }
 
-    return "No negative cycle detected";
+    // Find the path with the fewest edges from s to v.
+    string Algorithms::unweightedShortestPath(Graph &graph, int s, int v) {
+        checkVertices(graph.outEdges(), s, v);
+        BreadthFirstTree tree = breadthFirstSearch(graph, vector<size_t>(1, static_cast<size_t>(s)));
+        size_t i = static_cast<size_t>(v);
+        if (tree.hops[i] == BreadthFirstTree::UNVISITED) {
+            return "-1";
+        }
+        string path = to_string(i);
+        while (tree.parent[i] != BreadthFirstTree::UNVISITED) {
+            i = tree.parent[i];
+            path = to_string(i) + "->" + path;
+        }
+        return path;
     }
 }
@@ -1,6 +1,7 @@
 #ifndef ALGORITHMS_H
 #define ALGORITHMS_H
 
+#include <functional>
 #include <iostream>
 #include <stdexcept>
 #include <vector>
@@ -9,22 +10,228 @@
 #include <set>
 #include <climits> //for bellmanford
 #include <queue>
+#include <map>
+#include <string>
+#include "Parallel.hpp"
+#include "UnionFind.hpp"
 
 using namespace std;
 
 namespace ariel {
+    // A path (or cycle) as its sequence of vertices, together with the sum of its edge weights
+    struct Path {
+        vector<size_t> vertices;
+        long long weight = 0;
+    };
+
+    /*
+    Result of a single-source shortest path run: the distance and the predecessor of every vertex.
+    Two flat arrays indexed by vertex, so a tree is cheap to move, cache and query for many targets.
+    */
+    struct ShortestPathTree {
+        static constexpr size_t NO_PARENT = static_cast<size_t>(-1);
+
+        size_t source = 0;
+        // A negative cycle is reachable from the source, so the distances are not meaningful
+        bool negativeCycle = false;
+        // Algorithms::UNREACHABLE for vertices without a path
+        vector<long long> distance;
+        // Previous vertex on the shortest path, NO_PARENT for the source and unreachable vertices
+        vector<size_t> parent;
+
+        bool hasPath(size_t v) const;
+
+        vector<size_t> pathTo(size_t v) const;
+
+        string pathString(size_t v) const;
+
+        size_t memoryBytes() const;
+    };
+
+    // Component label of every vertex. Labels are 0..count-1, numbered in order of each component's smallest vertex.
+    struct Components {
+        vector<size_t> component;
+        // Number of vertices in each component, indexed by label
+        vector<size_t> sizes;
+        size_t count = 0;
+    };
+
+    // Either a 2-coloring of the graph (edge directions ignored) or an odd cycle proving there is none
+    struct Bipartition {
+        bool bipartite = true;
+        vector<size_t> partA;
+        vector<size_t> partB;
+        // First vertex repeated at the end, empty if the graph is bipartite
+        vector<size_t> oddCycle;
+    };
+
+    // Maximum matching of a bipartite graph together with a minimum vertex cover of the same size (Koenig)
+    struct Matching {
+        static constexpr size_t UNMATCHED = static_cast<size_t>(-1);
+
+        // The vertex matched with every vertex, UNMATCHED if none
+        vector<size_t> mate;
+        size_t size = 0;
+        vector<size_t> vertexCover;
+    };
+
+    // Minimum cost assignment of a bipartite graph: every vertex of the smaller side is paired with one of the other side
+    struct Assignment {
+        // The vertex paired with every vertex, Matching::UNMATCHED if none
+        vector<size_t> mate;
+        size_t size = 0;
+        // Sum of the weights of the chosen edges
+        long long cost = 0;
+    };
+
+    // Result of a breadth-first search: hop count, BFS parent and originating source of every vertex
+    struct BreadthFirstTree {
+        static constexpr size_t UNVISITED = static_cast<size_t>(-1);
+
+        // Number of edges from the nearest source, UNVISITED if not reached
+        vector<size_t> hops;
+        // Previous vertex on a fewest-edges path, UNVISITED for sources and unreached vertices
+        vector<size_t> parent;
+        // The source each vertex was reached from, UNVISITED if not reached
+        vector<size_t> root;
+        size_t reached = 0;
+    };
+
+    // What isConnected checks on a directed graph (all three agree on undirected graphs)
+    enum class Connectivity {
+        Reachable, // every vertex is reachable from vertex 0
+        Strong,    // every vertex is reachable from every other vertex
+        Weak       // connected when edge directions are ignored
+    };
+
     class Algorithms {
     public:
+        // Distance reported for vertices that cannot be reached from the source
+        static constexpr long long UNREACHABLE = LLONG_MAX;
+
          static bool isConnected(Graph &graph);
 
+        static bool isConnected(Graph &graph, Connectivity mode);
+
+        // Direction-optimizing BFS from all sources at once, optionally treating every edge as undirected
+        static BreadthFirstTree breadthFirstSearch(Graph &graph, const vector<size_t> &sources, bool ignoreDirection = false);
+
+        // Number of edges on the fewest-edges path from source to every vertex (BreadthFirstTree::UNVISITED if none)
+        static vector<size_t> hopDistances(Graph &graph, size_t source);
+
+        // Path with the fewest edges from s to v, ignoring weights, in the same format as shortestPath
+        static string unweightedShortestPath(Graph &graph, int s, int v);
+
+        // Strongly connected components with an iterative Tarjan (no recursion, any graph size)
+        static Components stronglyConnectedComponents(Graph &graph);
+
+        // Strongly connected components with parallel trimming, forward-backward search and coloring
+        static Components parallelStronglyConnectedComponents(Graph &graph);
+
+        // Weakly connected components with union-find
+        static Components weaklyConnectedComponents(Graph &graph);
+
+        // Weakly connected components on all worker threads: lock-free union-find with Afforest edge sampling
+        static Components parallelConnectedComponents(Graph &graph);
+
         static string shortestPath(Graph &graph, int s, int v);
 
          static string isContainsCycle(Graph &graph);
 
+        // A directed cycle, first vertex repeated at the end (e.g. 0, 1, 2, 0), or an empty list if the graph is acyclic
+        static vector<size_t> findDirectedCycle(Graph &graph);
+
+        // A cycle of at least three vertices with edge directions ignored, or an empty list if the graph is a forest
+        static vector<size_t> findUndirectedCycle(Graph &graph);
+
+        /*
+        Call visit(cycle) for every elementary directed cycle with at most maxLength edges (0 = no bound), the first
+        vertex repeated at the end. visit returns false to stop. Returns the number of cycles visited.
+        */
+        static size_t elementaryCycles(Graph &graph, const function<bool(const vector<size_t> &)> &visit, size_t maxLength = 0);
+
+        // The same enumeration on all worker threads: visit calls never overlap but come in no particular order
+        static size_t parallelElementaryCycles(Graph &graph, const function<bool(const vector<size_t> &)> &visit, size_t maxLength = 0);
+
+        // Fewest edges on any cycle (undirected if the graph is symmetric), UNREACHABLE if there is none
+        static long long girth(Graph &graph);
+
+        // Lightest cycle, first vertex repeated at the end (non-negative weights), empty if there is none
+        static Path shortestCycle(Graph &graph);
+
+        // Cycle with the lowest mean edge weight (Howard's policy iteration per SCC, in parallel, Karp as fallback), empty if none
+        static Path minimumMeanCycle(Graph &graph);
+
+        // Vertices ordered so that every edge goes forward (Kahn), throws if the graph has a directed cycle
+        static vector<size_t> topologicalSort(Graph &graph);
+
+        // The same order built level by level on all worker threads
+        static vector<size_t> parallelTopologicalSort(Graph &graph);
+
+        // Shortest / longest paths from source in a directed acyclic graph in O(V + E), any weights
+        static ShortestPathTree dagShortestPaths(Graph &graph, size_t source);
+
+        static ShortestPathTree dagLongestPaths(Graph &graph, size_t source);
+
          static string isBipartite(Graph &graph);
 
+        // Parallel 2-coloring of all components at once, with an odd cycle as the certificate when it fails
+        static Bipartition bipartition(Graph &graph);
+
+        // Maximum matching with Hopcroft-Karp in O(E sqrt(V)), edge directions ignored. Throws if the graph is not bipartite.
+        static Matching maximumMatching(Graph &graph);
+
+        // The same with the partition of an earlier bipartition call
+        static Matching maximumMatching(Graph &graph, const Bipartition &parts);
+
+        // Parallel push-relabel matching finished by Hopcroft-Karp, for very large graphs
+        static Matching parallelMaximumMatching(Graph &graph);
+
+        static Matching parallelMaximumMatching(Graph &graph, const Bipartition &parts);
+
+        /*
+        Minimum cost assignment with the Hungarian algorithm in O(n^3) on a dense cost matrix (n = size of the larger side).
+        The cost of pairing a and b is the weight of a->b, or of b->a if only that edge exists.
+        Throws if the graph is not bipartite or the smaller side cannot be fully assigned.
+        */
+        static Assignment minimumCostAssignment(Graph &graph);
+
+        static Assignment minimumCostAssignment(Graph &graph, const Bipartition &parts);
+
+        // The same assignment with a parallel auction algorithm (epsilon scaling), for large sparse instances
+        static Assignment parallelMinimumCostAssignment(Graph &graph);
+
+        static Assignment parallelMinimumCostAssignment(Graph &graph, const Bipartition &parts);
+
          static string negativeCycle(Graph &graph);
 
+        // Negative cycle reachable from source with Bellman-Ford-Tarjan: vertices (first one repeated) and total weight, empty if none
+        static Path findNegativeCycle(Graph &graph, size_t source);
+
+        // Negative cycle anywhere in the graph, searched from a virtual source with a zero-weight edge to every vertex
+        static Path findNegativeCycle(Graph &graph);
+
+        // Vertex-disjoint negative cycles, removing each cycle found and searching the rest again (limit 0: all of them)
+        static vector<Path> disjointNegativeCycles(Graph &graph, size_t limit = 0);
+
+        // Parallel single-source distances for non-negative weights, delta = 0 picks the bucket width automatically
+        static vector<long long> deltaStepping(Graph &graph, size_t source, long long delta = 0);
+
+        // Shortest path with Dial's bucket queue, for small non-negative integer weights
+        static string shortestPathDial(Graph &graph, int s, int v);
+
+        // Shortest path with a radix heap, for any non-negative integer weights
+        static string shortestPathRadixHeap(Graph &graph, int s, int v);
+
+        // Distances and predecessors from source to every vertex, so one run answers any number of targets
+        static ShortestPathTree singleSourceShortestPaths(Graph &graph, size_t source);
+
+        // Bellman-Ford relaxing the frontier of every round on the worker threads, for any weights
+        static ShortestPathTree parallelBellmanFord(Graph &graph, size_t source);
+
+        // Up to k loopless paths from source to target in increasing weight order (non-negative weights)
+        static vector<Path> kShortestPaths(Graph &graph, size_t source, size_t target, size_t k);
+
     };
 }
 
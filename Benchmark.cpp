@@ -0,0 +1,237 @@
+/*
+ * Timing runs for the parallel and incremental algorithms: make benchmark && ./benchmark
+ * The graphs are generated from a fixed seed, so runs are comparable between machines and commits.
+ */
+
+#include "Graph.hpp"
+#include "Algorithms.hpp"
+#include "DynamicConnectivity.hpp"
+#include "IncrementalBipartiteness.hpp"
+#include "IncrementalConnectivity.hpp"
+#include "OnlineTopologicalOrder.hpp"
+#include "Parallel.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <set>
+#include <stack>
+#include <vector>
+using namespace std;
+
+namespace {
+    unsigned long long state = 2024;
+
+    size_t nextRandom() {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<size_t>(state >> 33);
+    }
+
+    double elapsedMilliseconds(chrono::steady_clock::time_point start) {
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    }
+
+    // Nanoseconds per edge for the first and the last `batch` insertions of `edges` random edges
+    template <typename Insert>
+    void perEdge(const string &name, size_t vertices, size_t edges, size_t batch, Insert insert) {
+        vector<double> times;
+        for (size_t done = 0; done < edges; done += batch) {
+            auto start = chrono::steady_clock::now();
+            for (size_t i = 0; i < batch; i++) {
+                size_t u = nextRandom() % vertices, v = nextRandom() % vertices;
+                insert(u, v == u ? (v + 1) % vertices : v);
+            }
+            times.push_back(elapsedMilliseconds(start) * 1e6 / static_cast<double>(batch));
+        }
+        cout << "  " << name << " V=" << vertices << ": first " << batch << " edges " << times.front()
+             << " ns/edge, last " << batch << " edges " << times.back() << " ns/edge" << endl;
+    }
+
+    // Random graph with `degree` out-edges per vertex. With negative set, the weights are shifted by vertex potentials,
+    // so many are negative but every cycle keeps a positive weight.
+    vector<vector<int>> randomGraph(size_t vertices, size_t degree, bool negative) {
+        vector<int> potential(vertices, 0);
+        if (negative) {
+            for (size_t v = 0; v < vertices; v++) {
+                potential[v] = static_cast<int>(nextRandom() % 50);
+            }
+        }
+        vector<vector<int>> matrix(vertices, vector<int>(vertices, 0));
+        for (size_t u = 0; u < vertices; u++) {
+            for (size_t i = 0; i < degree; i++) {
+                size_t v = nextRandom() % vertices;
+                if (v != u) {
+                    int weight = static_cast<int>(1 + nextRandom() % 100) + potential[u] - potential[v];
+                    // 0 would mean no edge, and raising it keeps every cycle positive
+                    matrix[u][v] = weight == 0 ? 1 : weight;
+                }
+            }
+        }
+        return matrix;
+    }
+
+    // isConnected as it was before it walked the sparse adjacency: a std::set of visited vertices and a DFS that
+    // scans whole matrix rows, kept here as the baseline for the timing below
+    bool matrixIsConnected(const ariel::Graph &graph) {
+        size_t vertices = graph.matrix.size();
+        if (vertices == 0) {
+            return true;
+        }
+        set<size_t> visited;
+        stack<size_t> pending;
+        pending.push(0);
+        while (!pending.empty()) {
+            size_t vertex = pending.top();
+            pending.pop();
+            if (visited.find(vertex) == visited.end()) {
+                visited.insert(vertex);
+                for (size_t adj = 0; adj < vertices; adj++) {
+                    if (graph.matrix[vertex][adj] != 0) {
+                        pending.push(adj);
+                    }
+                }
+            }
+        }
+        return visited.size() == vertices;
+    }
+
+    // Best time of `repeats` runs in milliseconds
+    template <typename Solve>
+    double bestOf(size_t repeats, Solve solve) {
+        double best = 0;
+        for (size_t r = 0; r < repeats; r++) {
+            auto start = chrono::steady_clock::now();
+            solve();
+            double time = elapsedMilliseconds(start);
+            if (r == 0 || time < best) {
+                best = time;
+            }
+        }
+        return best;
+    }
+}
+
+int main() {
+    cout << "Incremental structures, cost per update (the graph side is O(1), so it tracks the structure alone):" << endl;
+    for (size_t vertices : {size_t(1000), size_t(2000), size_t(4000)}) {
+        ariel::Graph g;
+        g.loadGraph(vector<vector<int>>(vertices, vector<int>(vertices, 0)));
+        ariel::IncrementalConnectivity connectivity(g);
+        perEdge("IncrementalConnectivity", vertices, 4 * vertices, vertices, [&](size_t u, size_t v) {
+            connectivity.addEdge(u, v, 1);
+        });
+    }
+    for (size_t vertices : {size_t(1000), size_t(2000), size_t(4000)}) {
+        // Even vertices on one side and odd ones on the other, so the graph stays bipartite
+        ariel::Graph g;
+        g.loadGraph(vector<vector<int>>(vertices, vector<int>(vertices, 0)));
+        ariel::IncrementalBipartiteness bipartiteness(g);
+        perEdge("IncrementalBipartiteness", vertices, 4 * vertices, vertices, [&](size_t u, size_t v) {
+            bipartiteness.addEdge(u - u % 2, v | 1, 1);
+        });
+    }
+    for (size_t vertices : {size_t(1000), size_t(2000), size_t(4000)}) {
+        // Every other update removes an earlier edge, so tree edges get cut and replaced
+        ariel::Graph g;
+        g.loadGraph(vector<vector<int>>(vertices, vector<int>(vertices, 0)));
+        ariel::DynamicConnectivity connectivity(g);
+        vector<pair<size_t, size_t>> added;
+        perEdge("DynamicConnectivity (insert + delete)", vertices, 4 * vertices, vertices, [&](size_t u, size_t v) {
+            connectivity.addEdge(u, v, 1);
+            added.emplace_back(u, v);
+            if (added.size() % 2 == 0) {
+                size_t victim = nextRandom() % added.size();
+                connectivity.removeEdge(added[victim].first, added[victim].second);
+                added[victim] = added.back();
+                added.pop_back();
+            }
+        });
+    }
+    for (size_t vertices : {size_t(1000), size_t(2000), size_t(4000)}) {
+        // Edges follow a hidden random order, so they never close a cycle but often need a reorder
+        ariel::Graph g;
+        g.loadGraph(vector<vector<int>>(vertices, vector<int>(vertices, 0)));
+        ariel::OnlineTopologicalOrder order(g);
+        vector<size_t> hidden(vertices);
+        for (size_t v = 0; v < vertices; v++) {
+            hidden[v] = v;
+        }
+        for (size_t v = vertices - 1; v > 0; v--) {
+            swap(hidden[v], hidden[nextRandom() % (v + 1)]);
+        }
+        perEdge("OnlineTopologicalOrder", vertices, 2 * vertices, vertices, [&](size_t u, size_t v) {
+            if (hidden[u] < hidden[v]) {
+                order.addEdge(u, v, 1);
+            } else {
+                order.addEdge(v, u, 1);
+            }
+        });
+    }
+
+    {
+        // The largest sparse graph that comfortably fits the dense matrix loadGraph needs (V^2 ints, about 1 GB): an
+        // undirected ring, so it is connected, plus a random chord from every vertex, about 4 out-edges per vertex
+        const size_t vertices = 16000;
+        ariel::Graph sparse;
+        {
+            vector<vector<int>> matrix(vertices, vector<int>(vertices, 0));
+            for (size_t u = 0; u < vertices; u++) {
+                size_t ring = (u + 1) % vertices, chord = nextRandom() % vertices;
+                matrix[u][ring] = matrix[ring][u] = 1;
+                if (chord != u) {
+                    matrix[u][chord] = matrix[chord][u] = 1;
+                }
+            }
+            sparse.loadGraph(matrix);
+        }
+        bool connected = true;
+        double current = bestOf(3, [&]() { connected = connected && ariel::Algorithms::isConnected(sparse); });
+        double baseline = bestOf(3, [&]() { connected = connected && matrixIsConnected(sparse); });
+        cout << "isConnected on V=" << vertices << ", E=" << sparse.outEdges().edgeCount() << ", best of 3 runs:" << endl;
+        cout << "  sparse BFS " << current << " ms, previous matrix DFS " << baseline << " ms"
+             << (connected ? "" : " (NOT CONNECTED)") << endl;
+    }
+
+    // Same graphs and sources for every worker count; singleSourceShortestPaths runs with one worker, so it stays
+    // on the sequential Dijkstra / Bellman-Ford it picks for the weights
+    const size_t vertices = 4000, degree = 16, repeats = 3;
+    ariel::Graph positive, negative;
+    positive.loadGraph(randomGraph(vertices, degree, false));
+    negative.loadGraph(randomGraph(vertices, degree, true));
+    ariel::Parallel::setWorkers(1);
+    double dijkstra = bestOf(repeats, [&]() { ariel::Algorithms::singleSourceShortestPaths(positive, 0); });
+    double bellmanFord = bestOf(repeats, [&]() { ariel::Algorithms::singleSourceShortestPaths(negative, 0); });
+    vector<long long> expectedPositive = ariel::Algorithms::singleSourceShortestPaths(positive, 0).distance;
+    vector<long long> expectedNegative = ariel::Algorithms::singleSourceShortestPaths(negative, 0).distance;
+    ariel::Parallel::setWorkers(0);
+    size_t hardware = ariel::Parallel::workers();
+
+    cout << "Shortest paths on V=" << vertices << ", E=" << positive.outEdges().edgeCount() << " (hardware threads: "
+         << hardware << "), best of " << repeats << " runs:" << endl;
+    cout << "  singleSourceShortestPaths, non-negative weights: " << dijkstra << " ms" << endl;
+    cout << "  singleSourceShortestPaths, negative weights: " << bellmanFord << " ms" << endl;
+    vector<size_t> counts = {1, 4};
+    if (hardware != 1 && hardware != 4) {
+        counts.push_back(hardware);
+    }
+    for (size_t threads : counts) {
+        ariel::Parallel::setWorkers(threads);
+        bool same = true;
+        double delta = bestOf(repeats, [&]() {
+            same = same && ariel::Algorithms::deltaStepping(positive, 0) == expectedPositive;
+        });
+        double frontier = bestOf(repeats, [&]() {
+            same = same && ariel::Algorithms::parallelBellmanFord(negative, 0).distance == expectedNegative;
+        });
+        // Per-call cost of the worker hand-off, with bodies too small to matter
+        atomic<size_t> sink(0);
+        double handOff = bestOf(repeats, [&]() {
+            for (size_t call = 0; call < 1000; call++) {
+                ariel::Parallel::forEach(threads * 4, 1, [&](size_t, size_t begin, size_t) { sink += begin; });
+            }
+        });
+        cout << "  workers=" << threads << ": deltaStepping " << delta << " ms, parallelBellmanFord " << frontier
+             << " ms, forEach " << handOff << " us/call" << (same ? "" : " (DISTANCES DIFFER)") << endl;
+    }
+    ariel::Parallel::setWorkers(0);
+    return 0;
+}
@@ -0,0 +1,434 @@
+#include "DynamicConnectivity.hpp"
+
+namespace ariel {
+
+    constexpr size_t DynamicConnectivity::NIL;
+
+    DynamicConnectivity::DynamicConnectivity(Graph &graph)
+        : graph(graph), syncedVersion(0), vertexCount(0), componentCount(0), seed(2463534242u) {
+        synchronize();
+    }
+
+    void DynamicConnectivity::addEdge(size_t u, size_t v, int weight) {
+        synchronize();
+        bool existed = u < vertexCount && v < vertexCount && graph.matrix[u][v] != 0;
+        graph.addEdge(u, v, weight);
+        if (!existed) {
+            insertEdge(u, v);
+        }
+        syncedVersion = graph.version();
+    }
+
+    void DynamicConnectivity::removeEdge(size_t u, size_t v) {
+        synchronize();
+        bool existed = u < vertexCount && v < vertexCount && graph.matrix[u][v] != 0;
+        graph.removeEdge(u, v);
+        if (existed) {
+            deleteEdge(u, v);
+        }
+        syncedVersion = graph.version();
+    }
+
+    bool DynamicConnectivity::connected(size_t u, size_t v) {
+        synchronize();
+        checkVertex(u);
+        checkVertex(v);
+        return rootOf(vertexNodes[u][0]) == rootOf(vertexNodes[v][0]);
+    }
+
+    bool DynamicConnectivity::isConnected() {
+        synchronize();
+        return componentCount <= 1;
+    }
+
+    size_t DynamicConnectivity::components() {
+        synchronize();
+        return componentCount;
+    }
+
+    size_t DynamicConnectivity::componentSize(size_t v) {
+        synchronize();
+        checkVertex(v);
+        return nodes[rootOf(vertexNodes[v][0])].vertices;
+    }
+
+    void DynamicConnectivity::synchronize() {
+        if (syncedVersion == graph.version()) {
+            return;
+        }
+        const Adjacency &adj = graph.outEdges();
+        vertexCount = adj.vertexCount();
+        componentCount = vertexCount;
+        nodes.clear();
+        freeNodes.clear();
+        edges.clear();
+        freeEdges.clear();
+        edgeIndex.clear();
+        vertexNodes.assign(vertexCount, vector<size_t>());
+        nonTree.assign(vertexCount, vector<vector<size_t>>());
+        for (size_t x = 0; x < vertexCount; x++) {
+            vertexNode(x, 0);
+        }
+        for (size_t u = 0; u < vertexCount; u++) {
+            for (size_t e = adj.offsets[u]; e < adj.offsets[u + 1]; e++) {
+                insertEdge(u, adj.targets[e]);
+            }
+        }
+        syncedVersion = graph.version();
+    }
+
+    void DynamicConnectivity::checkVertex(size_t v) const {
+        if (v >= vertexCount) {
+            throw std::invalid_argument("Invalid vertex: vertex does not exist.");
+        }
+    }
+
+    unsigned long long DynamicConnectivity::key(size_t u, size_t v) const {
+        if (u > v) {
+            swap(u, v);
+        }
+        return static_cast<unsigned long long>(u) * vertexCount + v;
+    }
+
+    void DynamicConnectivity::insertEdge(size_t u, size_t v) {
+        unsigned long long k = key(u, v);
+        auto found = edgeIndex.find(k);
+        if (found != edgeIndex.end()) {
+            edges[found->second].count++;
+            return;
+        }
+
+        size_t e;
+        if (freeEdges.empty()) {
+            e = edges.size();
+            edges.emplace_back();
+        } else {
+            e = freeEdges.back();
+            freeEdges.pop_back();
+            edges[e] = Edge();
+        }
+        edges[e].u = u;
+        edges[e].v = v;
+        edges[e].count = 1;
+        edgeIndex[k] = e;
+
+        if (rootOf(vertexNodes[u][0]) == rootOf(vertexNodes[v][0])) {
+            addNonTree(e);
+        } else {
+            edges[e].tree = true;
+            link(e, 0);
+            componentCount--;
+        }
+    }
+
+    void DynamicConnectivity::deleteEdge(size_t u, size_t v) {
+        auto found = edgeIndex.find(key(u, v));
+        size_t e = found->second;
+        if (--edges[e].count > 0) {
+            return;
+        }
+        edgeIndex.erase(found);
+
+        if (!edges[e].tree) {
+            removeNonTree(e);
+            freeEdges.push_back(e);
+            return;
+        }
+        size_t level = edges[e].level;
+        for (size_t i = 0; i <= level; i++) {
+            cut(e, i);
+        }
+        u = edges[e].u;
+        v = edges[e].v;
+        edges[e].arcs.clear();
+        freeEdges.push_back(e);
+        replace(u, v, level);
+    }
+
+    void DynamicConnectivity::replace(size_t u, size_t v, size_t level) {
+        for (size_t i = level + 1; i-- > 0;) {
+            size_t rootU = rootOf(vertexNodes[u][i]);
+            size_t rootV = rootOf(vertexNodes[v][i]);
+            size_t small = nodes[rootU].vertices <= nodes[rootV].vertices ? rootU : rootV;
+
+            // The smaller half has at most half the vertices, so its level i tree edges can move up a level
+            vector<size_t> found;
+            collect(small, true, found);
+            for (size_t arc : found) {
+                size_t e = nodes[arc].owner;
+                setFlag(arc, true, false);
+                edges[e].level = i + 1;
+                link(e, i + 1);
+            }
+
+            // Every non-tree edge of the smaller half either reconnects the halves or moves up a level
+            found.clear();
+            collect(small, false, found);
+            for (size_t vertex : found) {
+                size_t x = nodes[vertex].owner;
+                while (nonTree[x].size() > i && !nonTree[x][i].empty()) {
+                    size_t e = nonTree[x][i].back();
+                    size_t y = edges[e].u == x ? edges[e].v : edges[e].u;
+                    removeNonTree(e);
+                    if (rootOf(vertexNodes[y][i]) == small) {
+                        edges[e].level = i + 1;
+                        addNonTree(e);
+                    } else {
+                        edges[e].tree = true;
+                        for (size_t j = 0; j <= i; j++) {
+                            link(e, j);
+                        }
+                        return;
+                    }
+                }
+            }
+        }
+        componentCount++;
+    }
+
+    void DynamicConnectivity::addNonTree(size_t e) {
+        Edge &edge = edges[e];
+        size_t ends[2] = {edge.u, edge.v};
+        for (size_t end = 0; end < 2; end++) {
+            size_t x = ends[end];
+            if (nonTree[x].size() <= edge.level) {
+                nonTree[x].resize(edge.level + 1);
+            }
+            vector<size_t> &list = nonTree[x][edge.level];
+            (end == 0 ? edge.positionU : edge.positionV) = list.size();
+            list.push_back(e);
+            if (list.size() == 1) {
+                setFlag(vertexNode(x, edge.level), false, true);
+            }
+        }
+    }
+
+    void DynamicConnectivity::removeNonTree(size_t e) {
+        Edge &edge = edges[e];
+        size_t ends[2] = {edge.u, edge.v};
+        for (size_t end = 0; end < 2; end++) {
+            size_t x = ends[end];
+            vector<size_t> &list = nonTree[x][edge.level];
+            size_t position = end == 0 ? edge.positionU : edge.positionV;
+            size_t moved = list.back();
+            list[position] = moved;
+            (edges[moved].u == x ? edges[moved].positionU : edges[moved].positionV) = position;
+            list.pop_back();
+            if (list.empty()) {
+                setFlag(vertexNodes[x][edge.level], false, false);
+            }
+        }
+    }
+
+    // Join the tours of u and v into u ... (u,v) v ... (v,u)
+    void DynamicConnectivity::link(size_t e, size_t level) {
+        size_t nodeU = vertexNode(edges[e].u, level);
+        size_t nodeV = vertexNode(edges[e].v, level);
+        reroot(nodeU);
+        reroot(nodeV);
+        size_t forward = newNode(false, e);
+        size_t backward = newNode(false, e);
+        if (edges[e].level == level) {
+            nodes[forward].treeEdge = true;
+            update(forward);
+        }
+        merge(merge(merge(rootOf(nodeU), forward), rootOf(nodeV)), backward);
+        if (edges[e].arcs.size() <= level) {
+            edges[e].arcs.resize(level + 1, make_pair(NIL, NIL));
+        }
+        edges[e].arcs[level] = make_pair(forward, backward);
+    }
+
+    // The tour X (u,v) Y (v,u) Z splits into X Z and Y
+    void DynamicConnectivity::cut(size_t e, size_t level) {
+        size_t first = edges[e].arcs[level].first;
+        size_t second = edges[e].arcs[level].second;
+        size_t root = rootOf(first);
+        size_t firstIndex = indexOf(first);
+        size_t secondIndex = indexOf(second);
+        if (firstIndex > secondIndex) {
+            swap(first, second);
+            swap(firstIndex, secondIndex);
+        }
+        size_t before, rest, arc, middle, after;
+        split(root, firstIndex, before, rest);
+        split(rest, 1, arc, rest);
+        split(rest, secondIndex - firstIndex - 1, middle, rest);
+        split(rest, 1, arc, after);
+        merge(before, after);
+        freeNode(first);
+        freeNode(second);
+    }
+
+    // Rotate the tour containing x so that it starts at x
+    void DynamicConnectivity::reroot(size_t x) {
+        size_t before, rest;
+        split(rootOf(x), indexOf(x), before, rest);
+        merge(rest, before);
+    }
+
+    size_t DynamicConnectivity::vertexNode(size_t x, size_t level) {
+        if (vertexNodes[x].size() <= level) {
+            vertexNodes[x].resize(level + 1, NIL);
+        }
+        if (vertexNodes[x][level] == NIL) {
+            size_t node = newNode(true, x);
+            vertexNodes[x][level] = node;
+            if (nonTree[x].size() > level && !nonTree[x][level].empty()) {
+                setFlag(node, false, true);
+            }
+        }
+        return vertexNodes[x][level];
+    }
+
+    void DynamicConnectivity::collect(size_t root, bool treeEdges, vector<size_t> &found) const {
+        vector<size_t> pending;
+        pending.push_back(root);
+        while (!pending.empty()) {
+            size_t x = pending.back();
+            pending.pop_back();
+            if (x == NIL || !(treeEdges ? nodes[x].anyTreeEdge : nodes[x].anyNonTreeEdges)) {
+                continue;
+            }
+            if (treeEdges ? nodes[x].treeEdge : nodes[x].nonTreeEdges) {
+                found.push_back(x);
+            }
+            pending.push_back(nodes[x].left);
+            pending.push_back(nodes[x].right);
+        }
+    }
+
+    size_t DynamicConnectivity::newNode(bool isVertex, size_t owner) {
+        size_t x;
+        if (freeNodes.empty()) {
+            x = nodes.size();
+            nodes.emplace_back();
+        } else {
+            x = freeNodes.back();
+            freeNodes.pop_back();
+            nodes[x] = Node();
+        }
+        // xorshift32 priorities
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        nodes[x].priority = seed;
+        nodes[x].isVertex = isVertex;
+        nodes[x].owner = owner;
+        update(x);
+        return x;
+    }
+
+    void DynamicConnectivity::freeNode(size_t x) {
+        freeNodes.push_back(x);
+    }
+
+    void DynamicConnectivity::update(size_t x) {
+        Node &node = nodes[x];
+        node.size = 1;
+        node.vertices = node.isVertex ? 1 : 0;
+        node.anyTreeEdge = node.treeEdge;
+        node.anyNonTreeEdges = node.nonTreeEdges;
+        size_t children[2] = {node.left, node.right};
+        for (size_t child : children) {
+            if (child != NIL) {
+                node.size += nodes[child].size;
+                node.vertices += nodes[child].vertices;
+                node.anyTreeEdge = node.anyTreeEdge || nodes[child].anyTreeEdge;
+                node.anyNonTreeEdges = node.anyNonTreeEdges || nodes[child].anyNonTreeEdges;
+            }
+        }
+    }
+
+    void DynamicConnectivity::setFlag(size_t x, bool treeEdge, bool value) {
+        (treeEdge ? nodes[x].treeEdge : nodes[x].nonTreeEdges) = value;
+        for (; x != NIL; x = nodes[x].parent) {
+            update(x);
+        }
+    }
+
+    size_t DynamicConnectivity::merge(size_t a, size_t b) {
+        size_t root = mergeNodes(a, b);
+        if (root != NIL) {
+            nodes[root].parent = NIL;
+        }
+        return root;
+    }
+
+    size_t DynamicConnectivity::mergeNodes(size_t a, size_t b) {
+        if (a == NIL) {
+            return b;
+        }
+        if (b == NIL) {
+            return a;
+        }
+        if (nodes[a].priority > nodes[b].priority) {
+            size_t right = mergeNodes(nodes[a].right, b);
+            nodes[a].right = right;
+            nodes[right].parent = a;
+            update(a);
+            return a;
+        }
+        size_t left = mergeNodes(a, nodes[b].left);
+        nodes[b].left = left;
+        nodes[left].parent = b;
+        update(b);
+        return b;
+    }
+
+    void DynamicConnectivity::split(size_t t, size_t k, size_t &first, size_t &rest) {
+        splitNodes(t, k, first, rest);
+        if (first != NIL) {
+            nodes[first].parent = NIL;
+        }
+        if (rest != NIL) {
+            nodes[rest].parent = NIL;
+        }
+    }
+
+    // first gets the first k nodes of t in tour order
+    void DynamicConnectivity::splitNodes(size_t t, size_t k, size_t &first, size_t &rest) {
+        if (t == NIL) {
+            first = NIL;
+            rest = NIL;
+            return;
+        }
+        size_t leftSize = nodes[t].left == NIL ? 0 : nodes[nodes[t].left].size;
+        if (k <= leftSize) {
+            size_t middle;
+            splitNodes(nodes[t].left, k, first, middle);
+            nodes[t].left = middle;
+            if (middle != NIL) {
+                nodes[middle].parent = t;
+            }
+            update(t);
+            rest = t;
+        } else {
+            size_t middle;
+            splitNodes(nodes[t].right, k - leftSize - 1, middle, rest);
+            nodes[t].right = middle;
+            if (middle != NIL) {
+                nodes[middle].parent = t;
+            }
+            update(t);
+            first = t;
+        }
+    }
+
+    size_t DynamicConnectivity::rootOf(size_t x) const {
+        while (nodes[x].parent != NIL) {
+            x = nodes[x].parent;
+        }
+        return x;
+    }
+
+    size_t DynamicConnectivity::indexOf(size_t x) const {
+        size_t index = nodes[x].left == NIL ? 0 : nodes[nodes[x].left].size;
+        for (size_t parent = nodes[x].parent; parent != NIL; x = parent, parent = nodes[x].parent) {
+            if (nodes[parent].right == x) {
+                index += 1 + (nodes[parent].left == NIL ? 0 : nodes[nodes[parent].left].size);
+            }
+        }
+        return index;
+    }
+}
@@ -0,0 +1,146 @@
+#ifndef DYNAMICCONNECTIVITY_HPP
+#define DYNAMICCONNECTIVITY_HPP
+
+#include <unordered_map>
+#include <utility>
+#include "Graph.hpp"
+
+using namespace std;
+
+namespace ariel {
+    /*
+    Connected components of a graph that gains and loses edges (Holm, de Lichtenberg and Thorup).
+    Edges are treated as undirected (weak connectivity), u->v and v->u count as one link.
+
+    Every edge has a level. F_i is the spanning forest made of the tree edges of level >= i, and each
+    F_i is stored as Euler tours in treaps. When a tree edge is deleted, the smaller of the two halves
+    pushes its edges one level up while looking for a replacement edge, which keeps insert, delete and
+    connected at O(log^2 n) amortized time.
+    If the graph is changed some other way (loadGraph, calling Graph::addEdge directly, ...) everything is
+    rebuilt on the next call.
+    */
+    class DynamicConnectivity {
+    public:
+        explicit DynamicConnectivity(Graph &graph);
+
+        // Add the edge u->v to the graph (or change its weight) and update the forests
+        void addEdge(size_t u, size_t v, int weight);
+
+        // Remove the edge u->v from the graph if it exists and update the forests
+        void removeEdge(size_t u, size_t v);
+
+        // Are u and v in the same component
+        bool connected(size_t u, size_t v);
+
+        // Is the whole graph one component (an empty graph is connected)
+        bool isConnected();
+
+        size_t components();
+
+        // Number of vertices in the component of v
+        size_t componentSize(size_t v);
+
+    private:
+        static constexpr size_t NIL = static_cast<size_t>(-1);
+
+        // Treap node of an Euler tour: either a vertex or one direction of a tree edge
+        struct Node {
+            size_t left = NIL;
+            size_t right = NIL;
+            size_t parent = NIL;
+            unsigned priority = 0;
+            size_t size = 1;
+            size_t vertices = 0;
+            size_t owner = 0;
+            bool isVertex = false;
+            // Arc of a tree edge whose level is this forest's level / vertex with non-tree edges at this level
+            bool treeEdge = false;
+            bool nonTreeEdges = false;
+            // The same flags for the whole subtree
+            bool anyTreeEdge = false;
+            bool anyNonTreeEdges = false;
+        };
+
+        struct Edge {
+            size_t u = 0;
+            size_t v = 0;
+            size_t level = 0;
+            // Number of directed graph edges behind this undirected edge
+            size_t count = 0;
+            bool tree = false;
+            // Positions in the non-tree lists of u and v at this level
+            size_t positionU = 0;
+            size_t positionV = 0;
+            // The two arcs of a tree edge in every forest up to its level
+            vector<pair<size_t, size_t>> arcs;
+        };
+
+        Graph &graph;
+        unsigned long long syncedVersion;
+        size_t vertexCount;
+        size_t componentCount;
+        unsigned seed;
+
+        vector<Node> nodes;
+        vector<size_t> freeNodes;
+        vector<Edge> edges;
+        vector<size_t> freeEdges;
+        unordered_map<unsigned long long, size_t> edgeIndex;
+        // vertexNodes[x][i]: the node of x in F_i, created the first time x needs it
+        vector<vector<size_t>> vertexNodes;
+        // nonTree[x][i]: non-tree edges of level i at x
+        vector<vector<vector<size_t>>> nonTree;
+
+        void synchronize();
+
+        void checkVertex(size_t v) const;
+
+        unsigned long long key(size_t u, size_t v) const;
+
+        void insertEdge(size_t u, size_t v);
+
+        void deleteEdge(size_t u, size_t v);
+
+        // Look for an edge reconnecting u and v after the tree edge between them, of the given level, was cut
+        void replace(size_t u, size_t v, size_t level);
+
+        void addNonTree(size_t e);
+
+        void removeNonTree(size_t e);
+
+        // Euler tour operations on the forest of one level
+        void link(size_t e, size_t level);
+
+        void cut(size_t e, size_t level);
+
+        void reroot(size_t x);
+
+        size_t vertexNode(size_t x, size_t level);
+
+        // Every node below root with the tree edge (or non-tree edge) flag set
+        void collect(size_t root, bool treeEdges, vector<size_t> &found) const;
+
+        // Treap primitives
+        size_t newNode(bool isVertex, size_t owner);
+
+        void freeNode(size_t x);
+
+        void update(size_t x);
+
+        void setFlag(size_t x, bool treeEdge, bool value);
+
+        size_t merge(size_t a, size_t b);
+
+        size_t mergeNodes(size_t a, size_t b);
+
+        void split(size_t t, size_t k, size_t &first, size_t &rest);
+
+        void splitNodes(size_t t, size_t k, size_t &first, size_t &rest);
+
+        size_t rootOf(size_t x) const;
+
+        size_t indexOf(size_t x) const;
+    };
+}
+
+#endif
@@ -1,9 +1,15 @@
 #include "Graph.hpp"
+#include "ShortestPathCache.hpp"
 
 namespace ariel {
 
+    namespace {
+        // Versions come from one process-wide counter, so two graphs (or copies of one) never share a version
+        atomic<unsigned long long> versionCounter(0);
+    }
+
     // Constructor definition
-    Graph::Graph() {}
+    Graph::Graph() : statsStale(false), edgeTotal(0), asymmetricEdges(0), cycleStatus(Acyclicity::Unknown), currentVersion(++versionCounter) {}
 
 
     void Graph::loadGraph(const vector<vector<int>> &graph) {
@@ -27,8 +33,238 @@ namespace ariel {
         j = 0;
         i++;
     }
+    buildAdjacency();
+    cycleStatus = Acyclicity::Unknown;
+    currentVersion = ++versionCounter;
 }
 
+    void Graph::addEdge(size_t u, size_t v, int weight) {
+        if (u >= this->matrix.size() || v >= this->matrix.size()) {
+            throw std::invalid_argument("Invalid edge: vertex does not exist.");
+        }
+        if (u == v) {
+            throw std::invalid_argument("Invalid graph: cannot be edge between a vertex to itself.");
+        }
+        if (weight == 0) {
+            throw std::invalid_argument("Invalid edge: weight 0 means no edge.");
+        }
+        setEdge(u, v, weight);
+    }
+
+    void Graph::removeEdge(size_t u, size_t v) {
+        if (u >= this->matrix.size() || v >= this->matrix.size()) {
+            throw std::invalid_argument("Invalid edge: vertex does not exist.");
+        }
+        setEdge(u, v, 0);
+    }
+
+    // Write one matrix entry and mark its row and column, the sparse views are patched when next read
+    void Graph::setEdge(size_t u, size_t v, int weight) {
+        int previous = this->matrix[u][v];
+        bool existed = previous != 0;
+        if (existed != (weight != 0)) {
+            // Adding or removing u->v pairs or unpairs it with v->u
+            bool reverse = this->matrix[v][u] != 0;
+            if (reverse == existed) {
+                asymmetricEdges++;
+            } else {
+                asymmetricEdges--;
+            }
+            // Removing an edge keeps a DAG acyclic and adding one keeps a cycle
+            if (cycleStatus == (existed ? Acyclicity::Cyclic : Acyclicity::Acyclic)) {
+                cycleStatus = Acyclicity::Unknown;
+            }
+        }
+        this->matrix[u][v] = weight;
+        if (!rowChanged[u]) {
+            rowChanged[u] = 1;
+            changedRows.push_back(u);
+        }
+        if (!columnChanged[v]) {
+            columnChanged[v] = 1;
+            changedColumns.push_back(v);
+        }
+
+        // Keep the statistics from the old and new weight, rescanning only if the minimum or maximum went away
+        if (existed) {
+            edgeTotal--;
+            stats.negativeEdges -= previous < 0 ? 1U : 0U;
+            statsStale = statsStale || previous == stats.minWeight || previous == stats.maxWeight;
+        }
+        if (weight != 0) {
+            stats.negativeEdges += weight < 0 ? 1U : 0U;
+            stats.minWeight = edgeTotal == 0 ? weight : min(stats.minWeight, weight);
+            stats.maxWeight = edgeTotal == 0 ? weight : max(stats.maxWeight, weight);
+            edgeTotal++;
+        } else if (edgeTotal == 0) {
+            stats = WeightStatistics();
+            statsStale = false;
+        }
+        currentVersion = ++versionCounter;
+    }
+
+    // Collect the non-zero entries of every matrix row into the CSR arrays
+    void Graph::buildAdjacency() {
+        size_t vertices = this->matrix.size();
+        out.offsets.assign(vertices + 1, 0);
+        out.targets.clear();
+        out.weights.clear();
+        for (size_t u = 0; u < vertices; u++) {
+            for (size_t v = 0; v < vertices; v++) {
+                if (this->matrix[u][v] != 0) {
+                    out.targets.push_back(v);
+                    out.weights.push_back(this->matrix[u][v]);
+                }
+            }
+            out.offsets[u + 1] = out.targets.size();
+        }
+
+        // Transpose by counting the in-degrees, then placing every edge at its target's slot
+        in.offsets.assign(vertices + 1, 0);
+        for (size_t v : out.targets) {
+            in.offsets[v + 1]++;
+        }
+        for (size_t v = 0; v < vertices; v++) {
+            in.offsets[v + 1] += in.offsets[v];
+        }
+        in.targets.resize(out.targets.size());
+        in.weights.resize(out.weights.size());
+        vector<size_t> next(in.offsets.begin(), in.offsets.end() - 1);
+        for (size_t u = 0; u < vertices; u++) {
+            for (size_t e = out.offsets[u]; e < out.offsets[u + 1]; e++) {
+                size_t slot = next[out.targets[e]]++;
+                in.targets[slot] = u;
+                in.weights[slot] = out.weights[e];
+            }
+        }
+
+        // Rows are sorted, so every reverse edge is a binary search away
+        asymmetricEdges = 0;
+        for (size_t u = 0; u < vertices; u++) {
+            for (size_t e = out.offsets[u]; e < out.offsets[u + 1]; e++) {
+                size_t v = out.targets[e];
+                auto rowBegin = out.targets.begin() + static_cast<ptrdiff_t>(out.offsets[v]);
+                auto rowEnd = out.targets.begin() + static_cast<ptrdiff_t>(out.offsets[v + 1]);
+                if (!binary_search(rowBegin, rowEnd, u)) {
+                    asymmetricEdges++;
+                }
+            }
+        }
+        edgeTotal = out.targets.size();
+        changedRows.clear();
+        changedColumns.clear();
+        rowChanged.assign(vertices, 0);
+        columnChanged.assign(vertices, 0);
+        computeStatistics();
+    }
+
+    // Copy the unchanged rows of both views and read the changed ones again from the matrix
+    void Graph::patchAdjacency() const {
+        size_t vertices = this->matrix.size();
+        auto patch = [&](Adjacency &adj, vector<size_t> &changed, vector<char> &flags, bool transposed) {
+            if (changed.empty()) {
+                return;
+            }
+            Adjacency patched;
+            patched.offsets.assign(vertices + 1, 0);
+            patched.targets.reserve(edgeTotal);
+            patched.weights.reserve(edgeTotal);
+            for (size_t r = 0; r < vertices; r++) {
+                if (flags[r]) {
+                    for (size_t c = 0; c < vertices; c++) {
+                        int weight = transposed ? this->matrix[c][r] : this->matrix[r][c];
+                        if (weight != 0) {
+                            patched.targets.push_back(c);
+                            patched.weights.push_back(weight);
+                        }
+                    }
+                    flags[r] = 0;
+                } else {
+                    patched.targets.insert(patched.targets.end(), adj.targets.begin() + static_cast<ptrdiff_t>(adj.offsets[r]),
+                                           adj.targets.begin() + static_cast<ptrdiff_t>(adj.offsets[r + 1]));
+                    patched.weights.insert(patched.weights.end(), adj.weights.begin() + static_cast<ptrdiff_t>(adj.offsets[r]),
+                                           adj.weights.begin() + static_cast<ptrdiff_t>(adj.offsets[r + 1]));
+                }
+                patched.offsets[r + 1] = patched.targets.size();
+            }
+            changed.clear();
+            adj = std::move(patched);
+        };
+        patch(out, changedRows, rowChanged, false);
+        patch(in, changedColumns, columnChanged, true);
+    }
+
+    void Graph::computeStatistics() const {
+        statsStale = false;
+        stats = WeightStatistics();
+        if (out.weights.empty()) {
+            return;
+        }
+        stats.minWeight = out.weights[0];
+        stats.maxWeight = out.weights[0];
+        for (int weight : out.weights) {
+            stats.minWeight = min(stats.minWeight, weight);
+            stats.maxWeight = max(stats.maxWeight, weight);
+            if (weight < 0) {
+                stats.negativeEdges++;
+            }
+        }
+    }
+
+    const Adjacency &Graph::outEdges() const {
+        patchAdjacency();
+        return out;
+    }
+
+    const Adjacency &Graph::inEdges() const {
+        patchAdjacency();
+        return in;
+    }
+
+    const WeightStatistics &Graph::weightStatistics() const {
+        if (statsStale) {
+            patchAdjacency();
+            computeStatistics();
+        }
+        return stats;
+    }
+
+    bool Graph::isSymmetric() const {
+        return asymmetricEdges == 0;
+    }
+
+    Acyclicity Graph::acyclicity() const {
+        return cycleStatus;
+    }
+
+    void Graph::recordAcyclicity(bool acyclic) {
+        cycleStatus = acyclic ? Acyclicity::Acyclic : Acyclicity::Cyclic;
+    }
+
+    unsigned long long Graph::version() const {
+        return currentVersion;
+    }
+
+    void Graph::enableShortestPathCache(size_t maxBytes) {
+        cache = make_shared<ShortestPathCache>(maxBytes);
+    }
+
+    void Graph::disableShortestPathCache() {
+        cache.reset();
+    }
+
+    ShortestPathCache *Graph::shortestPathCache() const {
+        return cache.get();
+    }
+
+    size_t Adjacency::vertexCount() const {
+        return offsets.empty() ? 0 : offsets.size() - 1;
+    }
+
+    size_t Adjacency::edgeCount() const {
+        return targets.size();
+    }
+
     void Graph::printGraph() {
         int size = this->matrix.size();
         int count = 0;
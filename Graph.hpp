@@ -1,12 +1,44 @@
 #ifndef GRAPH_HPP
 #define GRAPH_HPP
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
 #include <vector>
 
 using namespace std;
 
 namespace ariel {
+    // Compressed sparse row (CSR) form of an adjacency matrix: the out-neighbours of u are
+    // targets[offsets[u]] .. targets[offsets[u + 1] - 1], with the matching edge weights.
+    struct Adjacency {
+        vector<size_t> offsets;
+        vector<size_t> targets;
+        vector<int> weights;
+
+        size_t vertexCount() const;
+
+        size_t edgeCount() const;
+    };
+
+    // Summary of the edge weights, gathered by loadGraph so algorithms can pick a strategy without rescanning
+    struct WeightStatistics {
+        int minWeight = 0;
+        int maxWeight = 0;
+        size_t negativeEdges = 0;
+    };
+
+    // What is known about directed cycles in the current version of a graph
+    enum class Acyclicity {
+        Unknown,
+        Acyclic,
+        Cyclic
+    };
+
+    class ShortestPathCache;
+
     class Graph {
     public:
         vector<vector<int>> matrix;
@@ -19,6 +51,76 @@ namespace ariel {
 
         //Function to print the number of vertices and edges in the graph
         void printGraph();
+
+        /*
+        Add the edge u->v, or change its weight if it exists (weight must not be 0).
+        Edits cost O(1): they write the matrix, update the symmetry count and weight statistics, and mark row u and
+        column v. The next outEdges / inEdges call patches the sparse views in O(V + E + V * marked rows and columns),
+        so a batch of edits pays for one patch.
+        */
+        void addEdge(size_t u, size_t v, int weight);
+
+        // Remove the edge u->v if it exists (O(1), see addEdge)
+        void removeEdge(size_t u, size_t v);
+
+        // Changes whenever loadGraph, addEdge or removeEdge modify the graph (writing to matrix directly does not)
+        unsigned long long version() const;
+
+        // Keep recently computed shortest path trees, up to maxBytes, until the graph version changes
+        void enableShortestPathCache(size_t maxBytes);
+
+        void disableShortestPathCache();
+
+        // The attached cache, or nullptr if caching is disabled
+        ShortestPathCache *shortestPathCache() const;
+
+        /*
+        Sparse view of the matrix, rebuilt by loadGraph and patched here after addEdge / removeEdge.
+        Like the edits themselves, the first call after an edit must not run concurrently with other calls.
+        */
+        const Adjacency &outEdges() const;
+
+        // Sparse view of the transposed matrix: the in-neighbours of every vertex
+        const Adjacency &inEdges() const;
+
+        const WeightStatistics &weightStatistics() const;
+
+        // True if every edge u->v has a reverse edge v->u, i.e. the matrix describes an undirected graph
+        bool isSymmetric() const;
+
+        // Result of the last directed cycle check, Unknown once an edge change could have invalidated it
+        Acyclicity acyclicity() const;
+
+        // Store the result of a directed cycle check on the current version
+        void recordAcyclicity(bool acyclic);
+
+    private:
+        mutable Adjacency out;
+        mutable Adjacency in;
+        mutable WeightStatistics stats;
+        // An edit removed the minimum or maximum weight, so stats needs a rescan
+        mutable bool statsStale;
+        size_t edgeTotal;
+        // Rows of out and columns (rows of in) edited since the sparse views were last patched
+        mutable vector<size_t> changedRows;
+        mutable vector<size_t> changedColumns;
+        mutable vector<char> rowChanged;
+        mutable vector<char> columnChanged;
+        // Number of edges u->v without a matching v->u
+        size_t asymmetricEdges;
+        Acyclicity cycleStatus;
+        unsigned long long currentVersion;
+        // Copies of a graph share the cache, which is safe because their versions differ after any change
+        shared_ptr<ShortestPathCache> cache;
+
+        void buildAdjacency();
+
+        // Re-read the marked rows and columns of the matrix into out and in
+        void patchAdjacency() const;
+
+        void computeStatistics() const;
+
+        void setEdge(size_t u, size_t v, int weight);
     };
 }
 
@@ -0,0 +1,353 @@
+#include "HubLabels.hpp"
+#include "Algorithms.hpp"
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ariel {
+
+    namespace {
+        // "HUBLBL01" read as a little-endian word
+        const unsigned long long MAGIC = 0x31304c424c425548ULL;
+        const size_t HEADER_WORDS = 4;
+
+        struct LabelEntry {
+            unsigned hub; // rank of the hub vertex
+            long long distance;
+        };
+
+        /*
+        Check one side of the labels before any query reads it: offsets start at 0, never decrease and end at total,
+        so every label lies inside the arrays, and every label holds hub ids below n in increasing order, as the
+        merge in distance expects.
+        */
+        void checkLabels(const unsigned long long *offsets, const unsigned *hubs, size_t n, size_t total) {
+            if (offsets[0] != 0 || offsets[n] != total) {
+                throw std::runtime_error("Invalid hub label file: offsets do not match the header.");
+            }
+            for (size_t v = 0; v < n; v++) {
+                if (offsets[v + 1] < offsets[v]) {
+                    throw std::runtime_error("Invalid hub label file: offsets decrease.");
+                }
+            }
+            for (size_t v = 0; v < n; v++) {
+                for (unsigned long long i = offsets[v]; i < offsets[v + 1]; i++) {
+                    if (hubs[i] >= n || (i > offsets[v] && hubs[i] <= hubs[i - 1])) {
+                        throw std::runtime_error("Invalid hub label file: bad hub id.");
+                    }
+                }
+            }
+        }
+
+        // Words needed for n vertices and the given label totals (hubs are packed two per word at the end)
+        size_t layoutWords(size_t n, size_t outTotal, size_t inTotal) {
+            return HEADER_WORDS + 2 * (n + 1) + outTotal + inTotal + (outTotal + inTotal + 1) / 2;
+        }
+
+        /*
+        One pruned Dijkstra from root over `edges` (out-edges for the forward search, in-edges for the backward one).
+        rootLabel is the root's own label on the side facing the search, vertexLabels the labels it is pruned against.
+        Every vertex the current labels cannot already answer gets the entry (rank, distance), appended to additions.
+        */
+        void prunedSearch(const Adjacency &edges, size_t root, unsigned rank, const vector<LabelEntry> &rootLabel,
+                          const vector<vector<LabelEntry>> &vertexLabels, vector<long long> &hubDistance,
+                          vector<long long> &dist, vector<size_t> &touched, vector<pair<size_t, LabelEntry>> &additions) {
+            for (const LabelEntry &entry : rootLabel) {
+                hubDistance[entry.hub] = entry.distance;
+            }
+            typedef pair<long long, size_t> Entry;
+            priority_queue<Entry, vector<Entry>, greater<Entry>> open;
+            dist[root] = 0;
+            touched.push_back(root);
+            open.push(Entry(0, root));
+            while (!open.empty()) {
+                Entry top = open.top();
+                open.pop();
+                size_t v = top.second;
+                if (top.first != dist[v]) {
+                    continue;
+                }
+                // Prune if a hub of an earlier root already certifies this distance
+                bool covered = false;
+                for (const LabelEntry &entry : vertexLabels[v]) {
+                    long long viaHub = hubDistance[entry.hub];
+                    if (viaHub != Algorithms::UNREACHABLE && viaHub + entry.distance <= top.first) {
+                        covered = true;
+                        break;
+                    }
+                }
+                if (covered) {
+                    continue;
+                }
+                LabelEntry added = {rank, top.first};
+                additions.push_back(make_pair(v, added));
+                for (size_t e = edges.offsets[v]; e < edges.offsets[v + 1]; e++) {
+                    size_t t = edges.targets[e];
+                    long long candidate = top.first + edges.weights[e];
+                    if (candidate < dist[t]) {
+                        if (dist[t] == Algorithms::UNREACHABLE) {
+                            touched.push_back(t);
+                        }
+                        dist[t] = candidate;
+                        open.push(Entry(candidate, t));
+                    }
+                }
+            }
+            for (size_t v : touched) {
+                dist[v] = Algorithms::UNREACHABLE;
+            }
+            touched.clear();
+            for (const LabelEntry &entry : rootLabel) {
+                hubDistance[entry.hub] = Algorithms::UNREACHABLE;
+            }
+        }
+    }
+
+    HubLabels::HubLabels() {}
+
+    /*
+    Algorithm we are using: Pruned Landmark Labeling (Akiba, Iwata & Yoshida), batch-parallel as in ParaPLL
+
+        Step-by-Step:
+
+            1) Rank the vertices by total degree, so well connected vertices become hubs first.
+
+            2) Process the roots in rank order, one batch of (number of workers) roots at a time.
+               For each root run a forward Dijkstra (filling in-labels) and a backward one (filling out-labels),
+               pruned at every vertex whose distance the labels already answer.
+
+            3) Searches in a batch only see the labels of earlier batches, so they run in parallel and their
+               new entries are merged after the batch. This can only add redundant entries, never lose a distance.
+
+            4) Sort every label by hub rank and lay all of them out in one flat buffer.
+
+            -> Return the index.
+    */
+
+    // Build the hub labels of a graph.
+    HubLabels HubLabels::build(Graph &graph) {
+        const Adjacency &out = graph.outEdges();
+        const Adjacency &in = graph.inEdges();
+        size_t n = out.vertexCount();
+        if (graph.weightStatistics().negativeEdges > 0) {
+            throw std::invalid_argument("Hub labels require non-negative edge weights.");
+        }
+
+        vector<size_t> order(n);
+        for (size_t v = 0; v < n; v++) {
+            order[v] = v;
+        }
+        stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return out.offsets[a + 1] - out.offsets[a] + in.offsets[a + 1] - in.offsets[a] >
+                   out.offsets[b + 1] - out.offsets[b] + in.offsets[b + 1] - in.offsets[b];
+        });
+
+        vector<vector<LabelEntry>> outLabels(n); // (hub, dist(v, hub))
+        vector<vector<LabelEntry>> inLabels(n);  // (hub, dist(hub, v))
+
+        // Per-worker scratch space, reset after every search
+        size_t workers = Parallel::workers();
+        vector<vector<long long>> hubDistance(workers, vector<long long>(n, Algorithms::UNREACHABLE));
+        vector<vector<long long>> dist(workers, vector<long long>(n, Algorithms::UNREACHABLE));
+        vector<vector<size_t>> touched(workers);
+
+        for (size_t batchStart = 0; batchStart < n; batchStart += workers) {
+            size_t batchSize = min(workers, n - batchStart);
+            vector<vector<pair<size_t, LabelEntry>>> inAdditions(batchSize);
+            vector<vector<pair<size_t, LabelEntry>>> outAdditions(batchSize);
+            Parallel::forEach(batchSize, 1, [&](size_t worker, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    size_t root = order[batchStart + i];
+                    unsigned rank = static_cast<unsigned>(batchStart + i);
+                    prunedSearch(out, root, rank, outLabels[root], inLabels, hubDistance[worker], dist[worker], touched[worker], inAdditions[i]);
+                    prunedSearch(in, root, rank, inLabels[root], outLabels, hubDistance[worker], dist[worker], touched[worker], outAdditions[i]);
+                }
+            });
+            for (size_t i = 0; i < batchSize; i++) {
+                for (const auto &addition : inAdditions[i]) {
+                    inLabels[addition.first].push_back(addition.second);
+                }
+                for (const auto &addition : outAdditions[i]) {
+                    outLabels[addition.first].push_back(addition.second);
+                }
+            }
+        }
+
+        // Flatten into the file layout
+        size_t outTotal = 0, inTotal = 0;
+        for (size_t v = 0; v < n; v++) {
+            outTotal += outLabels[v].size();
+            inTotal += inLabels[v].size();
+        }
+        HubLabels labels;
+        labels.storage.assign(layoutWords(n, outTotal, inTotal), 0);
+        unsigned long long *words = labels.storage.data();
+        words[0] = MAGIC;
+        words[1] = n;
+        words[2] = outTotal;
+        words[3] = inTotal;
+        unsigned long long *outOffsets = words + HEADER_WORDS;
+        unsigned long long *inOffsets = outOffsets + n + 1;
+        long long *outDistances = reinterpret_cast<long long *>(inOffsets + n + 1);
+        long long *inDistances = outDistances + outTotal;
+        unsigned *outHubs = reinterpret_cast<unsigned *>(inDistances + inTotal);
+        unsigned *inHubs = outHubs + outTotal;
+        auto byHub = [](const LabelEntry &a, const LabelEntry &b) { return a.hub < b.hub; };
+        for (size_t v = 0; v < n; v++) {
+            sort(outLabels[v].begin(), outLabels[v].end(), byHub);
+            sort(inLabels[v].begin(), inLabels[v].end(), byHub);
+            outOffsets[v + 1] = outOffsets[v] + outLabels[v].size();
+            inOffsets[v + 1] = inOffsets[v] + inLabels[v].size();
+            for (size_t i = 0; i < outLabels[v].size(); i++) {
+                outHubs[outOffsets[v] + i] = outLabels[v][i].hub;
+                outDistances[outOffsets[v] + i] = outLabels[v][i].distance;
+            }
+            for (size_t i = 0; i < inLabels[v].size(); i++) {
+                inHubs[inOffsets[v] + i] = inLabels[v][i].hub;
+                inDistances[inOffsets[v] + i] = inLabels[v][i].distance;
+            }
+        }
+        labels.attach(words, labels.storage.size() * sizeof(unsigned long long));
+        return labels;
+    }
+
+    HubLabels HubLabels::load(const string &path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open hub label file: " + path);
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+            ::close(fd);
+            throw std::runtime_error("Invalid hub label file: " + path);
+        }
+        size_t bytes = static_cast<size_t>(info.st_size);
+        void *address = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (address == MAP_FAILED) {
+            throw std::runtime_error("Cannot map hub label file: " + path);
+        }
+        HubLabels labels;
+        labels.mapped = address;
+        labels.mappedBytes = bytes;
+        labels.attach(static_cast<const unsigned long long *>(address), bytes); // the destructor unmaps if this throws
+        return labels;
+    }
+
+    void HubLabels::save(const string &path) const {
+        ofstream file(path, ios::binary | ios::trunc);
+        file.write(reinterpret_cast<const char *>(buffer()), static_cast<streamsize>(bufferBytes()));
+        if (!file) {
+            throw std::runtime_error("Cannot write hub label file: " + path);
+        }
+    }
+
+    // Merge the sorted out-label of s with the sorted in-label of t.
+    long long HubLabels::distance(size_t s, size_t t) const {
+        if (s >= vertices || t >= vertices) {
+            throw std::invalid_argument("Invalid vertex: vertex does not exist.");
+        }
+        long long best = Algorithms::UNREACHABLE;
+        unsigned long long i = outOffsets[s], iEnd = outOffsets[s + 1];
+        unsigned long long j = inOffsets[t], jEnd = inOffsets[t + 1];
+        while (i < iEnd && j < jEnd) {
+            if (outHubs[i] < inHubs[j]) {
+                i++;
+            } else if (outHubs[i] > inHubs[j]) {
+                j++;
+            } else {
+                best = min(best, outDistances[i] + inDistances[j]);
+                i++;
+                j++;
+            }
+        }
+        return best;
+    }
+
+    size_t HubLabels::vertexCount() const {
+        return vertices;
+    }
+
+    size_t HubLabels::labelEntries() const {
+        return vertices == 0 ? 0 : static_cast<size_t>(outOffsets[vertices] + inOffsets[vertices]);
+    }
+
+    const unsigned long long *HubLabels::buffer() const {
+        return mapped != nullptr ? static_cast<const unsigned long long *>(mapped) : storage.data();
+    }
+
+    size_t HubLabels::bufferBytes() const {
+        return mapped != nullptr ? mappedBytes : storage.size() * sizeof(unsigned long long);
+    }
+
+    void HubLabels::attach(const unsigned long long *base, size_t bytes) {
+        if (bytes < HEADER_WORDS * sizeof(unsigned long long) || base[0] != MAGIC) {
+            throw std::runtime_error("Invalid hub label file: bad header.");
+        }
+        size_t words = bytes / sizeof(unsigned long long);
+        // No count can exceed the word count of the file, which also keeps layoutWords from overflowing
+        if (base[1] > words || base[2] > words || base[3] > words) {
+            throw std::runtime_error("Invalid hub label file: size does not match the header.");
+        }
+        size_t n = static_cast<size_t>(base[1]);
+        size_t outTotal = static_cast<size_t>(base[2]);
+        size_t inTotal = static_cast<size_t>(base[3]);
+        if (layoutWords(n, outTotal, inTotal) * sizeof(unsigned long long) != bytes) {
+            throw std::runtime_error("Invalid hub label file: size does not match the header.");
+        }
+        const unsigned long long *outOffsetWords = base + HEADER_WORDS;
+        const unsigned long long *inOffsetWords = outOffsetWords + n + 1;
+        const long long *outDistanceWords = reinterpret_cast<const long long *>(inOffsetWords + n + 1);
+        const unsigned *outHubWords = reinterpret_cast<const unsigned *>(outDistanceWords + outTotal + inTotal);
+        checkLabels(outOffsetWords, outHubWords, n, outTotal);
+        checkLabels(inOffsetWords, outHubWords + outTotal, n, inTotal);
+        vertices = n;
+        outOffsets = outOffsetWords;
+        inOffsets = inOffsetWords;
+        outDistances = outDistanceWords;
+        inDistances = outDistances + outTotal;
+        outHubs = outHubWords;
+        inHubs = outHubs + outTotal;
+    }
+
+    HubLabels::HubLabels(HubLabels &&other) noexcept {
+        *this = std::move(other);
+    }
+
+    HubLabels &HubLabels::operator=(HubLabels &&other) noexcept {
+        if (this != &other) {
+            release();
+            storage = std::move(other.storage); // moving a vector keeps its buffer, so the pointers stay valid
+            mapped = other.mapped;
+            mappedBytes = other.mappedBytes;
+            vertices = other.vertices;
+            outOffsets = other.outOffsets;
+            inOffsets = other.inOffsets;
+            outDistances = other.outDistances;
+            inDistances = other.inDistances;
+            outHubs = other.outHubs;
+            inHubs = other.inHubs;
+            other.mapped = nullptr;
+            other.mappedBytes = 0;
+            other.vertices = 0;
+        }
+        return *this;
+    }
+
+    HubLabels::~HubLabels() {
+        release();
+    }
+
+    void HubLabels::release() {
+        if (mapped != nullptr) {
+            munmap(const_cast<void *>(mapped), mappedBytes);
+            mapped = nullptr;
+            mappedBytes = 0;
+        }
+        storage.clear();
+        vertices = 0;
+    }
+}
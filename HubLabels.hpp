@@ -0,0 +1,74 @@
+#ifndef HUBLABELS_HPP
+#define HUBLABELS_HPP
+
+#include <string>
+#include <vector>
+#include "Graph.hpp"
+
+using namespace std;
+
+namespace ariel {
+    /*
+    Hub labeling (pruned landmark labeling) distance index for graphs with non-negative weights.
+    Every vertex v keeps two label arrays sorted by hub: the hubs it reaches with their distances (out-label)
+    and the hubs that reach it (in-label). dist(s, t) is the best hub shared by out(s) and in(t), so a query
+    is one merge of two short sorted arrays.
+    The labels live in one flat buffer with the same layout as the file written by save, so load can map the
+    file into memory and answer queries without parsing it.
+    */
+    class HubLabels {
+    public:
+        // Build the index, processing several roots at once on the worker threads
+        static HubLabels build(Graph &graph);
+
+        // Map an index written by save, read-only. The offsets and hub ids are checked once, so a damaged file throws
+        // here instead of reading out of bounds in distance
+        static HubLabels load(const string &path);
+
+        void save(const string &path) const;
+
+        // Same value as the shortest path distance, Algorithms::UNREACHABLE if there is no path
+        long long distance(size_t s, size_t t) const;
+
+        size_t vertexCount() const;
+
+        // Total number of (hub, distance) entries over all labels
+        size_t labelEntries() const;
+
+        HubLabels(HubLabels &&other) noexcept;
+
+        HubLabels &operator=(HubLabels &&other) noexcept;
+
+        HubLabels(const HubLabels &) = delete;
+
+        HubLabels &operator=(const HubLabels &) = delete;
+
+        ~HubLabels();
+
+    private:
+        vector<unsigned long long> storage; // the buffer when built in memory
+        const void *mapped = nullptr;       // the buffer when loaded from a file
+        size_t mappedBytes = 0;
+
+        size_t vertices = 0;
+        const unsigned long long *outOffsets = nullptr;
+        const unsigned long long *inOffsets = nullptr;
+        const long long *outDistances = nullptr;
+        const long long *inDistances = nullptr;
+        const unsigned *outHubs = nullptr;
+        const unsigned *inHubs = nullptr;
+
+        HubLabels();
+
+        const unsigned long long *buffer() const;
+
+        size_t bufferBytes() const;
+
+        // Point the label arrays into a buffer, checking that it is well formed
+        void attach(const unsigned long long *base, size_t bytes);
+
+        void release();
+    };
+}
+
+#endif
@@ -0,0 +1,133 @@
+#include "IncrementalBipartiteness.hpp"
+
+namespace ariel {
+
+    IncrementalBipartiteness::IncrementalBipartiteness(Graph &graph) : graph(graph), syncedVersion(0) {
+        synchronize();
+    }
+
+    bool IncrementalBipartiteness::addEdge(size_t u, size_t v, int weight) {
+        synchronize();
+        graph.addEdge(u, v, weight);
+        insertEdge(u, v);
+        syncedVersion = graph.version();
+        return cycle.empty();
+    }
+
+    bool IncrementalBipartiteness::isBipartite() {
+        synchronize();
+        return cycle.empty();
+    }
+
+    const vector<size_t> &IncrementalBipartiteness::oddCycle() {
+        synchronize();
+        return cycle;
+    }
+
+    vector<size_t> IncrementalBipartiteness::coloring() {
+        synchronize();
+        vector<size_t> sides;
+        if (!cycle.empty()) {
+            return sides;
+        }
+        sides.resize(parent.size());
+        for (size_t v = 0; v < parent.size(); v++) {
+            char side;
+            find(v, side);
+            sides[v] = static_cast<size_t>(side);
+        }
+        return sides;
+    }
+
+    void IncrementalBipartiteness::synchronize() {
+        if (syncedVersion == graph.version()) {
+            return;
+        }
+        const Adjacency &adj = graph.outEdges();
+        size_t vertices = adj.vertexCount();
+        parent.resize(vertices);
+        for (size_t v = 0; v < vertices; v++) {
+            parent[v] = v;
+        }
+        setSize.assign(vertices, 1);
+        parity.assign(vertices, 0);
+        forest.assign(vertices, vector<size_t>());
+        cycle.clear();
+        for (size_t u = 0; u < vertices && cycle.empty(); u++) {
+            for (size_t e = adj.offsets[u]; e < adj.offsets[u + 1]; e++) {
+                insertEdge(u, adj.targets[e]);
+            }
+        }
+        syncedVersion = graph.version();
+    }
+
+    void IncrementalBipartiteness::insertEdge(size_t u, size_t v) {
+        if (!cycle.empty()) {
+            // Adding edges never makes the graph bipartite again
+            return;
+        }
+        char sideU, sideV;
+        size_t rootU = find(u, sideU);
+        size_t rootV = find(v, sideV);
+        if (rootU == rootV) {
+            if (sideU == sideV) {
+                // The forest path between u and v has an even number of edges, u-v closes it into an odd cycle
+                cycle = forestPath(u, v);
+                cycle.push_back(u);
+            }
+            return;
+        }
+        if (setSize[rootU] < setSize[rootV]) {
+            swap(rootU, rootV);
+        }
+        // u and v must end up on different sides
+        parent[rootV] = rootU;
+        parity[rootV] = static_cast<char>(sideU ^ sideV ^ 1);
+        setSize[rootU] += setSize[rootV];
+        forest[u].push_back(v);
+        forest[v].push_back(u);
+    }
+
+    size_t IncrementalBipartiteness::find(size_t x, char &side) {
+        size_t root = x;
+        char total = 0;
+        while (parent[root] != root) {
+            total = static_cast<char>(total ^ parity[root]);
+            root = parent[root];
+        }
+        // Second pass: point every vertex on the path at the root, with its parity relative to the root
+        char remaining = total;
+        for (size_t node = x; parent[node] != root && node != root;) {
+            size_t next = parent[node];
+            char own = parity[node];
+            parity[node] = remaining;
+            parent[node] = root;
+            remaining = static_cast<char>(remaining ^ own);
+            node = next;
+        }
+        side = total;
+        return root;
+    }
+
+    vector<size_t> IncrementalBipartiteness::forestPath(size_t u, size_t v) const {
+        const size_t NONE = static_cast<size_t>(-1);
+        vector<size_t> previous(forest.size(), NONE);
+        vector<size_t> pending(1, u);
+        previous[u] = u;
+        for (size_t head = 0; head < pending.size() && previous[v] == NONE; head++) {
+            for (size_t w : forest[pending[head]]) {
+                if (previous[w] == NONE) {
+                    previous[w] = pending[head];
+                    pending.push_back(w);
+                }
+            }
+        }
+        vector<size_t> path;
+        for (size_t x = v; x != u; x = previous[x]) {
+            path.push_back(x);
+        }
+        path.push_back(u);
+        reverse(path.begin(), path.end());
+        return path;
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef INCREMENTALBIPARTITENESS_HPP
+#define INCREMENTALBIPARTITENESS_HPP
+
+#include "Graph.hpp"
+
+using namespace std;
+
+namespace ariel {
+    /*
+    Bipartiteness of a graph that only gains edges, kept in a union-find with a parity bit per element:
+    the parity of a vertex is its side relative to the root of its set. An edge inside one set whose
+    endpoints have the same parity closes an odd cycle. Edge directions are ignored.
+    The edges that merged two sets form a spanning forest, which gives the odd cycle as a vertex list.
+    If the graph is changed some other way (loadGraph, removeEdge, ...) everything is rebuilt on the next call.
+    */
+    class IncrementalBipartiteness {
+    public:
+        explicit IncrementalBipartiteness(Graph &graph);
+
+        // Add the edge u->v to the graph, returns true if the graph is still bipartite
+        bool addEdge(size_t u, size_t v, int weight);
+
+        bool isBipartite();
+
+        // The first odd cycle found (first vertex repeated at the end), empty while the graph is bipartite
+        const vector<size_t> &oddCycle();
+
+        // The side (0 or 1) of every vertex in a 2-coloring, empty if the graph is not bipartite
+        vector<size_t> coloring();
+
+    private:
+        Graph &graph;
+        unsigned long long syncedVersion;
+        vector<size_t> parent;
+        vector<size_t> setSize;
+        // Side of a vertex relative to its parent
+        vector<char> parity;
+        // Edges that merged two sets
+        vector<vector<size_t>> forest;
+        vector<size_t> cycle;
+
+        void synchronize();
+
+        void insertEdge(size_t u, size_t v);
+
+        // Root of the set of x, with the parity of x relative to it
+        size_t find(size_t x, char &side);
+
+        // Path from u to v in the spanning forest
+        vector<size_t> forestPath(size_t u, size_t v) const;
+    };
+}
+
+#endif
@@ -0,0 +1,58 @@
+#include "IncrementalConnectivity.hpp"
+
+namespace ariel {
+
+    IncrementalConnectivity::IncrementalConnectivity(Graph &graph) : graph(graph), syncedVersion(0) {
+        synchronize();
+    }
+
+    void IncrementalConnectivity::addEdge(size_t u, size_t v, int weight) {
+        synchronize();
+        graph.addEdge(u, v, weight);
+        sets.unite(u, v);
+        syncedVersion = graph.version();
+    }
+
+    bool IncrementalConnectivity::connected(size_t u, size_t v) {
+        synchronize();
+        checkVertex(u);
+        checkVertex(v);
+        return sets.connected(u, v);
+    }
+
+    bool IncrementalConnectivity::isConnected() {
+        synchronize();
+        return sets.sets() <= 1;
+    }
+
+    size_t IncrementalConnectivity::components() {
+        synchronize();
+        return sets.sets();
+    }
+
+    size_t IncrementalConnectivity::componentSize(size_t v) {
+        synchronize();
+        checkVertex(v);
+        return sets.size(v);
+    }
+
+    void IncrementalConnectivity::synchronize() {
+        if (syncedVersion == graph.version()) {
+            return;
+        }
+        const Adjacency &adj = graph.outEdges();
+        sets = UnionFind(adj.vertexCount());
+        for (size_t u = 0; u < adj.vertexCount(); u++) {
+            for (size_t e = adj.offsets[u]; e < adj.offsets[u + 1]; e++) {
+                sets.unite(u, adj.targets[e]);
+            }
+        }
+        syncedVersion = graph.version();
+    }
+
+    void IncrementalConnectivity::checkVertex(size_t v) const {
+        if (v >= sets.elements()) {
+            throw std::invalid_argument("Invalid vertex: vertex does not exist.");
+        }
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef INCREMENTALCONNECTIVITY_HPP
+#define INCREMENTALCONNECTIVITY_HPP
+
+#include "Graph.hpp"
+#include "UnionFind.hpp"
+
+using namespace std;
+
+namespace ariel {
+    /*
+    Connected components of a graph that only gains edges, kept in a union-find next to the graph.
+    Edges are treated as undirected (weak connectivity). Adding an edge through this class costs an O(1)
+    graph update plus a near-O(1) union, and queries never traverse the graph.
+    If the graph is changed some other way (loadGraph, removeEdge, ...) the components are rebuilt on the next call.
+    */
+    class IncrementalConnectivity {
+    public:
+        explicit IncrementalConnectivity(Graph &graph);
+
+        // Add the edge u->v to the graph and merge the components of u and v
+        void addEdge(size_t u, size_t v, int weight);
+
+        // Are u and v in the same component
+        bool connected(size_t u, size_t v);
+
+        // Is the whole graph one component (an empty graph is connected)
+        bool isConnected();
+
+        size_t components();
+
+        // Number of vertices in the component of v
+        size_t componentSize(size_t v);
+
+    private:
+        Graph &graph;
+        UnionFind sets;
+        unsigned long long syncedVersion;
+
+        // Rebuild the union-find if the graph changed behind our back
+        void synchronize();
+
+        void checkVertex(size_t v) const;
+    };
+}
+
+#endif
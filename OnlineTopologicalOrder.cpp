@@ -0,0 +1,167 @@
+#include "OnlineTopologicalOrder.hpp"
+#include "Algorithms.hpp"
+
+namespace ariel {
+
+    OnlineTopologicalOrder::OnlineTopologicalOrder(Graph &graph) : graph(graph), syncedVersion(0) {
+        synchronize();
+    }
+
+    vector<size_t> OnlineTopologicalOrder::addEdge(size_t u, size_t v, int weight) {
+        synchronize();
+        checkVertex(u);
+        checkVertex(v);
+        if (u == v) {
+            throw std::invalid_argument("Invalid graph: cannot be edge between a vertex to itself.");
+        }
+        if (weight == 0) {
+            throw std::invalid_argument("Invalid edge: weight 0 means no edge.");
+        }
+
+        vector<size_t> cycle;
+        if (graph.matrix[u][v] == 0 && rank[v] < rank[u]) {
+            // Only the vertices ranked between v and u can be out of order after adding u->v
+            vector<size_t> forward, backward;
+            bool closesCycle = searchForward(v, rank[u], u, forward);
+            if (closesCycle) {
+                for (size_t x = u; x != v; x = parent[x]) {
+                    cycle.push_back(x);
+                }
+                cycle.push_back(v);
+                reverse(cycle.begin(), cycle.end());
+                cycle.push_back(v);
+            } else {
+                searchBackward(u, rank[v], backward);
+                reorder(backward, forward);
+            }
+            for (size_t x : forward) {
+                visited[x] = 0;
+            }
+            for (size_t x : backward) {
+                visited[x] = 0;
+            }
+            if (closesCycle) {
+                return cycle;
+            }
+        }
+        if (graph.matrix[u][v] == 0) {
+            successors[u].push_back(v);
+            predecessors[v].push_back(u);
+        }
+        graph.addEdge(u, v, weight);
+        graph.recordAcyclicity(true);
+        syncedVersion = graph.version();
+        return cycle;
+    }
+
+    void OnlineTopologicalOrder::removeEdge(size_t u, size_t v) {
+        synchronize();
+        bool existed = u < rank.size() && v < rank.size() && graph.matrix[u][v] != 0;
+        graph.removeEdge(u, v);
+        if (existed) {
+            successors[u].erase(find(successors[u].begin(), successors[u].end(), v));
+            predecessors[v].erase(find(predecessors[v].begin(), predecessors[v].end(), u));
+        }
+        syncedVersion = graph.version();
+    }
+
+    size_t OnlineTopologicalOrder::position(size_t v) {
+        synchronize();
+        checkVertex(v);
+        return rank[v];
+    }
+
+    const vector<size_t> &OnlineTopologicalOrder::order() {
+        synchronize();
+        return vertexAt;
+    }
+
+    void OnlineTopologicalOrder::synchronize() {
+        if (syncedVersion == graph.version()) {
+            return;
+        }
+        vertexAt = Algorithms::topologicalSort(graph);
+        rank.assign(vertexAt.size(), 0);
+        for (size_t i = 0; i < vertexAt.size(); i++) {
+            rank[vertexAt[i]] = i;
+        }
+        visited.assign(vertexAt.size(), 0);
+        parent.assign(vertexAt.size(), 0);
+        const Adjacency &out = graph.outEdges();
+        successors.assign(vertexAt.size(), vector<size_t>());
+        predecessors.assign(vertexAt.size(), vector<size_t>());
+        for (size_t x = 0; x < vertexAt.size(); x++) {
+            for (size_t e = out.offsets[x]; e < out.offsets[x + 1]; e++) {
+                successors[x].push_back(out.targets[e]);
+                predecessors[out.targets[e]].push_back(x);
+            }
+        }
+        syncedVersion = graph.version();
+    }
+
+    void OnlineTopologicalOrder::checkVertex(size_t v) const {
+        if (v >= rank.size()) {
+            throw std::invalid_argument("Invalid vertex: vertex does not exist.");
+        }
+    }
+
+    bool OnlineTopologicalOrder::searchForward(size_t v, size_t upper, size_t target, vector<size_t> &reached) {
+        vector<size_t> pending(1, v);
+        visited[v] = 1;
+        reached.push_back(v);
+        while (!pending.empty()) {
+            size_t x = pending.back();
+            pending.pop_back();
+            for (size_t w : successors[x]) {
+                if (visited[w] || rank[w] > upper) {
+                    continue;
+                }
+                visited[w] = 1;
+                parent[w] = x;
+                reached.push_back(w);
+                if (w == target) {
+                    return true;
+                }
+                pending.push_back(w);
+            }
+        }
+        return false;
+    }
+
+    void OnlineTopologicalOrder::searchBackward(size_t u, size_t lower, vector<size_t> &reached) {
+        vector<size_t> pending(1, u);
+        visited[u] = 1;
+        reached.push_back(u);
+        while (!pending.empty()) {
+            size_t x = pending.back();
+            pending.pop_back();
+            for (size_t w : predecessors[x]) {
+                if (visited[w] || rank[w] < lower) {
+                    continue;
+                }
+                visited[w] = 1;
+                reached.push_back(w);
+                pending.push_back(w);
+            }
+        }
+    }
+
+    void OnlineTopologicalOrder::reorder(vector<size_t> &backward, vector<size_t> &forward) {
+        auto byRank = [this](size_t a, size_t b) { return rank[a] < rank[b]; };
+        sort(backward.begin(), backward.end(), byRank);
+        sort(forward.begin(), forward.end(), byRank);
+
+        vector<size_t> vertices(backward);
+        vertices.insert(vertices.end(), forward.begin(), forward.end());
+        vector<size_t> ranks;
+        ranks.reserve(vertices.size());
+        for (size_t x : vertices) {
+            ranks.push_back(rank[x]);
+        }
+        sort(ranks.begin(), ranks.end());
+        for (size_t i = 0; i < vertices.size(); i++) {
+            rank[vertices[i]] = ranks[i];
+            vertexAt[ranks[i]] = vertices[i];
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef ONLINETOPOLOGICALORDER_HPP
+#define ONLINETOPOLOGICALORDER_HPP
+
+#include "Graph.hpp"
+
+using namespace std;
+
+namespace ariel {
+    /*
+    A topological order of a directed acyclic graph that is kept up to date while edges are added (Pearce and Kelly).
+    An edge u->v that already points forward in the order costs O(1). Otherwise only the vertices between v and u
+    in the order are searched: the ones reachable from v and the ones reaching u are moved so that the edge points
+    forward, and if u is reachable from v the edge is rejected because it would close a cycle.
+    The graph update itself is O(1) (see Graph::addEdge), so an insertion costs time proportional to the searched region.
+    If the graph is changed some other way (loadGraph, calling Graph::addEdge directly, ...) the order is rebuilt
+    on the next call, which throws if the graph is no longer acyclic.
+    */
+    class OnlineTopologicalOrder {
+    public:
+        // Throws if the graph has a directed cycle
+        explicit OnlineTopologicalOrder(Graph &graph);
+
+        /*
+        Add the edge u->v to the graph (or change its weight) unless it would create a cycle.
+        Returns an empty list if the edge was added, otherwise the cycle it would close
+        (v, ..., u, v) and the graph is left unchanged.
+        */
+        vector<size_t> addEdge(size_t u, size_t v, int weight);
+
+        // Remove the edge u->v from the graph, the order stays valid
+        void removeEdge(size_t u, size_t v);
+
+        // Index of v in the order
+        size_t position(size_t v);
+
+        // The vertices in topological order
+        const vector<size_t> &order();
+
+    private:
+        Graph &graph;
+        unsigned long long syncedVersion;
+        // rank[v] is the position of v, vertexAt[i] the vertex at position i
+        vector<size_t> rank;
+        vector<size_t> vertexAt;
+        // Out- and in-neighbours, updated with every edge so a search never waits for the graph's sparse views
+        vector<vector<size_t>> successors;
+        vector<vector<size_t>> predecessors;
+        // Search marks, reset after every insertion by walking the touched vertices only
+        vector<char> visited;
+        vector<size_t> parent;
+
+        void synchronize();
+
+        void checkVertex(size_t v) const;
+
+        // DFS from v over vertices ranked up to upper, filling reached. Returns true if it reached target.
+        bool searchForward(size_t v, size_t upper, size_t target, vector<size_t> &reached);
+
+        // DFS from u over the reversed edges of vertices ranked from lower on
+        void searchBackward(size_t u, size_t lower, vector<size_t> &reached);
+
+        // Give the vertices of backward, then forward, the ranks they already occupy in increasing order
+        void reorder(vector<size_t> &backward, vector<size_t> &forward);
+    };
+}
+
+#endif
@@ -0,0 +1,131 @@
+#include "Parallel.hpp"
+#include <condition_variable>
+#include <mutex>
+
+namespace ariel {
+
+    namespace {
+        /*
+        Threads kept between forEach calls. Every call publishes its job and bumps the generation, the threads it
+        needs run job(index) and the last one to finish wakes the caller. Threads are only added, never removed,
+        and are stopped when the program exits.
+        */
+        class WorkerPool {
+        public:
+            ~WorkerPool() {
+                {
+                    lock_guard<mutex> guard(lock);
+                    stopping = true;
+                }
+                wake.notify_all();
+                for (auto &t : threads) {
+                    t.join();
+                }
+            }
+
+            void run(size_t threads, const function<void(size_t)> &job);
+
+        private:
+            mutex lock;
+            condition_variable wake;
+            condition_variable done;
+            vector<thread> threads;
+            const function<void(size_t)> *current = nullptr;
+            // Threads 1 .. wanted take part in the current generation, pending of them are still running
+            size_t wanted = 0;
+            size_t pending = 0;
+            unsigned long long generation = 0;
+            bool stopping = false;
+
+            void loop(size_t index);
+        };
+
+        // Set on threads running a forEach body, so nested calls do not wait for the workers they are running on
+        thread_local bool insideForEach = false;
+        // One forEach at a time uses the workers, concurrent callers run alone
+        mutex callerLock;
+
+        void WorkerPool::run(size_t count, const function<void(size_t)> &job) {
+            {
+                lock_guard<mutex> guard(lock);
+                while (threads.size() + 1 < count) {
+                    threads.emplace_back(&WorkerPool::loop, this, threads.size() + 1);
+                }
+                current = &job;
+                wanted = count - 1;
+                pending = count - 1;
+                generation++;
+            }
+            wake.notify_all();
+            insideForEach = true;
+            job(0);
+            insideForEach = false;
+            unique_lock<mutex> guard(lock);
+            done.wait(guard, [this] { return pending == 0; });
+            current = nullptr;
+        }
+
+        void WorkerPool::loop(size_t index) {
+            unsigned long long seen = 0;
+            unique_lock<mutex> guard(lock);
+            while (true) {
+                wake.wait(guard, [&] { return stopping || generation != seen; });
+                if (stopping) {
+                    return;
+                }
+                seen = generation;
+                if (index > wanted) {
+                    continue;
+                }
+                const function<void(size_t)> *job = current;
+                guard.unlock();
+                insideForEach = true;
+                (*job)(index);
+                insideForEach = false;
+                guard.lock();
+                if (--pending == 0) {
+                    done.notify_all();
+                }
+            }
+        }
+
+        WorkerPool &pool() {
+            static WorkerPool instance;
+            return instance;
+        }
+    }
+
+    atomic<size_t> Parallel::configuredWorkers(0);
+
+    size_t Parallel::workers() {
+        size_t configured = configuredWorkers.load(memory_order_relaxed);
+        if (configured != 0) {
+            return configured;
+        }
+        unsigned hardware = thread::hardware_concurrency();
+        return hardware == 0 ? 1 : hardware;
+    }
+
+    void Parallel::setWorkers(size_t count) {
+        configuredWorkers.store(count, memory_order_relaxed);
+    }
+
+    bool Parallel::atomicMin(atomic<long long> &target, long long value) {
+        long long current = target.load(memory_order_relaxed);
+        while (value < current) {
+            if (target.compare_exchange_weak(current, value, memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Parallel::run(size_t threads, const function<void(size_t)> &job) {
+        if (insideForEach || !callerLock.try_lock()) {
+            job(0);
+            return;
+        }
+        lock_guard<mutex> guard(callerLock, adopt_lock);
+        pool().run(threads, job);
+    }
+}
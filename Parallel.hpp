@@ -0,0 +1,67 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace ariel {
+    class Parallel {
+    public:
+        // Number of threads the parallel algorithms use (defaults to the hardware concurrency)
+        static size_t workers();
+
+        // Override the number of threads, 0 restores the default
+        static void setWorkers(size_t count);
+
+        // Lower target to value if value is smaller, returns true if target was lowered
+        static bool atomicMin(atomic<long long> &target, long long value);
+
+        /*
+        Run body(worker, begin, end) over the range [0, count).
+        Threads take blocks of `grain` indices from a shared counter, so uneven work balances itself out.
+        The threads are started once and reused by every call, so a call costs a wake-up rather than thread creation.
+        Small ranges, nested calls and calls made while another thread is using the workers run on the calling
+        thread only. body must not throw.
+        */
+        template <typename Body>
+        static void forEach(size_t count, size_t grain, Body body) {
+            if (grain == 0) {
+                grain = 1;
+            }
+            size_t blocks = (count + grain - 1) / grain;
+            size_t threads = min(workers(), blocks);
+            if (threads <= 1) {
+                if (count > 0) {
+                    body(static_cast<size_t>(0), static_cast<size_t>(0), count);
+                }
+                return;
+            }
+
+            atomic<size_t> next(0);
+            function<void(size_t)> job = [&](size_t worker) {
+                while (true) {
+                    size_t begin = next.fetch_add(grain);
+                    if (begin >= count) {
+                        break;
+                    }
+                    body(worker, begin, min(begin + grain, count));
+                }
+            };
+            run(threads, job);
+        }
+
+    private:
+        // Atomic because any thread may start an algorithm (and read it) while another calls setWorkers
+        static atomic<size_t> configuredWorkers;
+
+        // Call job(worker) for workers 0 .. threads - 1: 0 on the calling thread, the others on the persistent threads
+        static void run(size_t threads, const function<void(size_t)> &job);
+    };
+}
+
+#endif
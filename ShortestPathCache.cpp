@@ -0,0 +1,91 @@
+#include "ShortestPathCache.hpp"
+
+namespace ariel {
+
+    ShortestPathCache::ShortestPathCache(size_t maxBytes) : maxBytes(maxBytes) {}
+
+    shared_ptr<const ShortestPathTree> ShortestPathCache::find(unsigned long long version, size_t source) {
+        lock_guard<mutex> guard(lock);
+        switchVersion(version);
+        auto entry = bySource.find(source);
+        if (entry == bySource.end()) {
+            missCount++;
+            return nullptr;
+        }
+        hitCount++;
+        recency.splice(recency.begin(), recency, entry->second); // move to the front, iterators stay valid
+        return *entry->second;
+    }
+
+    void ShortestPathCache::insert(unsigned long long version, const shared_ptr<const ShortestPathTree> &tree) {
+        size_t size = tree->memoryBytes();
+        lock_guard<mutex> guard(lock);
+        switchVersion(version);
+        if (size > maxBytes || bySource.count(tree->source) > 0) {
+            return;
+        }
+        while (usedBytes + size > maxBytes) {
+            const shared_ptr<const ShortestPathTree> &oldest = recency.back();
+            usedBytes -= oldest->memoryBytes();
+            bySource.erase(oldest->source);
+            recency.pop_back();
+            evictionCount++;
+        }
+        recency.push_front(tree);
+        bySource[tree->source] = recency.begin();
+        usedBytes += size;
+    }
+
+    void ShortestPathCache::clear() {
+        lock_guard<mutex> guard(lock);
+        recency.clear();
+        bySource.clear();
+        usedBytes = 0;
+    }
+
+    // Drop all entries if they were computed for another version of the graph
+    void ShortestPathCache::switchVersion(unsigned long long newVersion) {
+        if (newVersion == version) {
+            return;
+        }
+        invalidationCount += recency.size();
+        recency.clear();
+        bySource.clear();
+        usedBytes = 0;
+        version = newVersion;
+    }
+
+    size_t ShortestPathCache::hits() const {
+        lock_guard<mutex> guard(lock);
+        return hitCount;
+    }
+
+    size_t ShortestPathCache::misses() const {
+        lock_guard<mutex> guard(lock);
+        return missCount;
+    }
+
+    size_t ShortestPathCache::evictions() const {
+        lock_guard<mutex> guard(lock);
+        return evictionCount;
+    }
+
+    size_t ShortestPathCache::invalidations() const {
+        lock_guard<mutex> guard(lock);
+        return invalidationCount;
+    }
+
+    size_t ShortestPathCache::entries() const {
+        lock_guard<mutex> guard(lock);
+        return recency.size();
+    }
+
+    size_t ShortestPathCache::bytes() const {
+        lock_guard<mutex> guard(lock);
+        return usedBytes;
+    }
+
+    size_t ShortestPathCache::capacityBytes() const {
+        return maxBytes;
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef SHORTESTPATHCACHE_HPP
+#define SHORTESTPATHCACHE_HPP
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "Algorithms.hpp"
+
+using namespace std;
+
+namespace ariel {
+    /*
+    Least-recently-used cache of shortest path trees, keyed by (graph version, source) and bounded by memory.
+    All entries belong to one graph version: a lookup or insert with a newer version drops everything first.
+    Safe to use from several threads.
+    */
+    class ShortestPathCache {
+    public:
+        explicit ShortestPathCache(size_t maxBytes);
+
+        // The cached tree for source, or nullptr (counted as a hit or a miss)
+        shared_ptr<const ShortestPathTree> find(unsigned long long version, size_t source);
+
+        // Store a tree, evicting the least recently used ones until it fits. Trees larger than the budget are not kept.
+        void insert(unsigned long long version, const shared_ptr<const ShortestPathTree> &tree);
+
+        void clear();
+
+        size_t hits() const;
+
+        size_t misses() const;
+
+        // Entries dropped to make room for new ones
+        size_t evictions() const;
+
+        // Entries dropped because the graph version changed
+        size_t invalidations() const;
+
+        size_t entries() const;
+
+        size_t bytes() const;
+
+        size_t capacityBytes() const;
+
+    private:
+        typedef list<shared_ptr<const ShortestPathTree>> Recency; // most recently used first
+
+        mutable mutex lock;
+        size_t maxBytes;
+        size_t usedBytes = 0;
+        unsigned long long version = 0;
+        Recency recency;
+        unordered_map<size_t, Recency::iterator> bySource;
+        size_t hitCount = 0;
+        size_t missCount = 0;
+        size_t evictionCount = 0;
+        size_t invalidationCount = 0;
+
+        void switchVersion(unsigned long long newVersion);
+    };
+}
+
+#endif
@@ -1,6 +1,15 @@
 #include "doctest.h"
 #include "Algorithms.hpp"
 #include "Graph.hpp"
+#include "HubLabels.hpp"
+#include "DynamicConnectivity.hpp"
+#include "IncrementalBipartiteness.hpp"
+#include "IncrementalConnectivity.hpp"
+#include "OnlineTopologicalOrder.hpp"
+#include "ShortestPathCache.hpp"
+#include <climits>
+#include <cstdio>
+#include <fstream>
 
 using namespace std;
 
@@ -183,3 +192,1438 @@ TEST_CASE("Test invalid graph")
         {0, 0, 0, 5}};
     CHECK_THROWS(g.loadGraph(graph2));
 }
+
+TEST_CASE("Test deltaStepping")
+{
+    ariel::Graph g;
+    vector<vector<int>> graph = {
+        {0, 4, 1, 0, 0},
+        {0, 0, 0, 1, 0},
+        {0, 2, 0, 5, 0},
+        {0, 0, 0, 0, 3},
+        {0, 0, 0, 0, 0}};
+    g.loadGraph(graph);
+    vector<long long> expected = {0, 3, 1, 4, 7};
+    CHECK(ariel::Algorithms::deltaStepping(g, 0) == expected);
+    CHECK(ariel::Algorithms::deltaStepping(g, 0, 1) == expected);
+    CHECK(ariel::Algorithms::deltaStepping(g, 0, 100) == expected);
+
+    vector<long long> fromFour = {ariel::Algorithms::UNREACHABLE, ariel::Algorithms::UNREACHABLE,
+                                  ariel::Algorithms::UNREACHABLE, ariel::Algorithms::UNREACHABLE, 0};
+    CHECK(ariel::Algorithms::deltaStepping(g, 4) == fromFour);
+
+    // A long weighted ring with chords, relaxed by several threads
+    size_t n = 2000;
+    vector<vector<int>> ring(n, vector<int>(n, 0));
+    for (size_t i = 0; i < n; i++) {
+        ring[i][(i + 1) % n] = static_cast<int>(i % 7) + 1;
+        ring[i][(i + 37) % n] = 50;
+    }
+    g.loadGraph(ring);
+    ariel::Parallel::setWorkers(1);
+    vector<long long> sequential = ariel::Algorithms::deltaStepping(g, 0, 3);
+    ariel::Parallel::setWorkers(4);
+    CHECK(ariel::Algorithms::deltaStepping(g, 0) == sequential);
+    CHECK(ariel::Algorithms::deltaStepping(g, 0, 1) == sequential);
+    ariel::Parallel::setWorkers(0);
+
+    vector<vector<int>> negative = {
+        {0, -1},
+        {1, 0}};
+    g.loadGraph(negative);
+    CHECK_THROWS(ariel::Algorithms::deltaStepping(g, 0));
+    CHECK_THROWS(ariel::Algorithms::deltaStepping(g, 2));
+}
+
+TEST_CASE("Test integer weight Dijkstra")
+{
+    ariel::Graph g;
+    vector<vector<int>> graph = {
+        {0, 4, 1, 0, 0},
+        {0, 0, 0, 1, 0},
+        {0, 2, 0, 5, 0},
+        {0, 0, 0, 0, 3},
+        {0, 0, 0, 0, 0}};
+    g.loadGraph(graph);
+    CHECK(g.weightStatistics().minWeight == 1);
+    CHECK(g.weightStatistics().maxWeight == 5);
+    CHECK(g.weightStatistics().negativeEdges == 0);
+    CHECK(ariel::Algorithms::shortestPathDial(g, 0, 4) == "0->2->1->3->4");
+    CHECK(ariel::Algorithms::shortestPathRadixHeap(g, 0, 4) == "0->2->1->3->4");
+    CHECK(ariel::Algorithms::shortestPathDial(g, 4, 0) == "-1");
+    CHECK(ariel::Algorithms::shortestPathRadixHeap(g, 3, 3) == "3");
+
+    // Large weights: shortestPath switches to the radix heap
+    vector<vector<int>> heavy = {
+        {0, 100000, 7000, 0},
+        {0, 0, 0, 1},
+        {0, 90000, 0, 400000},
+        {0, 0, 0, 0}};
+    g.loadGraph(heavy);
+    CHECK(g.weightStatistics().maxWeight == 400000);
+    CHECK(ariel::Algorithms::shortestPath(g, 0, 3) == "0->2->1->3");
+    CHECK(ariel::Algorithms::shortestPathDial(g, 0, 3) == "0->2->1->3");
+
+    vector<vector<int>> negative = {
+        {0, -1},
+        {1, 0}};
+    g.loadGraph(negative);
+    CHECK(g.weightStatistics().negativeEdges == 1);
+    CHECK_THROWS(ariel::Algorithms::shortestPathDial(g, 0, 1));
+    CHECK_THROWS(ariel::Algorithms::shortestPathRadixHeap(g, 0, 1));
+    CHECK_THROWS(ariel::Algorithms::shortestPath(g, 0, 5));
+}
+
+TEST_CASE("Test kShortestPaths")
+{
+    ariel::Graph g;
+    // Classic Yen example: C=0, D=1, E=2, F=3, G=4, H=5
+    vector<vector<int>> graph = {
+        {0, 3, 2, 0, 0, 0},
+        {0, 0, 0, 4, 0, 0},
+        {0, 1, 0, 2, 3, 0},
+        {0, 0, 0, 0, 2, 1},
+        {0, 0, 0, 0, 0, 2},
+        {0, 0, 0, 0, 0, 0}};
+    g.loadGraph(graph);
+    vector<ariel::Path> paths = ariel::Algorithms::kShortestPaths(g, 0, 5, 3);
+    CHECK(paths.size() == 3);
+    CHECK(paths[0].vertices == vector<size_t>({0, 2, 3, 5}));
+    CHECK(paths[0].weight == 5);
+    CHECK(paths[1].weight == 7);
+    CHECK(paths[2].weight == 8);
+
+    // Asking for more paths than exist returns all of them, cheapest first
+    paths = ariel::Algorithms::kShortestPaths(g, 0, 5, 100);
+    CHECK(paths.size() == 7);
+    for (size_t i = 1; i < paths.size(); i++) {
+        CHECK(paths[i - 1].weight <= paths[i].weight);
+        CHECK(set<size_t>(paths[i].vertices.begin(), paths[i].vertices.end()).size() == paths[i].vertices.size());
+    }
+
+    CHECK(ariel::Algorithms::kShortestPaths(g, 5, 0, 3).empty());
+    CHECK(ariel::Algorithms::kShortestPaths(g, 0, 0, 3).size() == 1);
+    CHECK_THROWS(ariel::Algorithms::kShortestPaths(g, 0, 6, 3));
+}
+
+TEST_CASE("Test singleSourceShortestPaths")
+{
+    ariel::Graph g;
+    vector<vector<int>> graph = {
+        {0, 4, 1, 0, 0},
+        {0, 0, 0, 1, 0},
+        {0, 2, 0, 5, 0},
+        {0, 0, 0, 0, 3},
+        {0, 0, 0, 0, 0}};
+    g.loadGraph(graph);
+    ariel::ShortestPathTree tree = ariel::Algorithms::singleSourceShortestPaths(g, 0);
+    CHECK(tree.distance == vector<long long>({0, 3, 1, 4, 7}));
+    CHECK(tree.parent[0] == ariel::ShortestPathTree::NO_PARENT);
+    CHECK(tree.pathTo(4) == vector<size_t>({0, 2, 1, 3, 4}));
+    CHECK(tree.pathString(3) == "0->2->1->3");
+
+    ariel::ShortestPathTree fromThree = ariel::Algorithms::singleSourceShortestPaths(g, 3);
+    CHECK(fromThree.hasPath(4));
+    CHECK_FALSE(fromThree.hasPath(0));
+    CHECK(fromThree.pathTo(0).empty());
+    CHECK(fromThree.pathString(0) == "-1");
+
+    // Negative weights go through Bellman-Ford
+    vector<vector<int>> negative = {
+        {0, 4, 2, 0},
+        {0, 0, 0, 1},
+        {0, -3, 0, 6},
+        {0, 0, 0, 0}};
+    g.loadGraph(negative);
+    tree = ariel::Algorithms::singleSourceShortestPaths(g, 0);
+    CHECK_FALSE(tree.negativeCycle);
+    CHECK(tree.distance == vector<long long>({0, -1, 2, 0}));
+    CHECK(ariel::Algorithms::shortestPath(g, 0, 3) == "0->2->1->3");
+
+    vector<vector<int>> cycle = {
+        {0, 1, 0},
+        {0, 0, -2},
+        {0, 1, 0}};
+    g.loadGraph(cycle);
+    CHECK(ariel::Algorithms::singleSourceShortestPaths(g, 0).negativeCycle);
+    CHECK(ariel::Algorithms::shortestPath(g, 0, 2) == "-1");
+}
+
+TEST_CASE("Test shortest path cache")
+{
+    ariel::Graph g;
+    vector<vector<int>> graph = {
+        {0, 4, 1, 0},
+        {0, 0, 0, 1},
+        {0, 2, 0, 5},
+        {0, 0, 0, 0}};
+    g.loadGraph(graph);
+    CHECK(g.shortestPathCache() == nullptr);
+    g.enableShortestPathCache(1 << 20);
+    ariel::ShortestPathCache *cache = g.shortestPathCache();
+
+    CHECK(ariel::Algorithms::shortestPath(g, 0, 3) == "0->2->1->3");
+    CHECK(ariel::Algorithms::shortestPath(g, 0, 1) == "0->2->1");
+    CHECK(ariel::Algorithms::singleSourceShortestPaths(g, 0).distance[3] == 4);
+    CHECK(cache->misses() == 1);
+    CHECK(cache->hits() == 2);
+    CHECK(cache->entries() == 1);
+
+    // A mutation bumps the version, so the next query recomputes
+    unsigned long long before = g.version();
+    g.addEdge(0, 3, 2);
+    CHECK(g.version() != before);
+    CHECK(g.matrix[0][3] == 2);
+    CHECK(ariel::Algorithms::shortestPath(g, 0, 3) == "0->3");
+    CHECK(cache->invalidations() == 1);
+    CHECK(cache->misses() == 2);
+    g.removeEdge(0, 3);
+    CHECK(ariel::Algorithms::shortestPath(g, 0, 3) == "0->2->1->3");
+    g.loadGraph(graph);
+    CHECK(ariel::Algorithms::shortestPath(g, 2, 3) == "2->1->3");
+    CHECK(cache->misses() == 4);
+    CHECK_THROWS(g.addEdge(1, 1, 3));
+    CHECK_THROWS(g.addEdge(0, 1, 0));
+
+    // A budget of about one tree evicts the least recently used source
+    size_t treeBytes = ariel::Algorithms::singleSourceShortestPaths(g, 2).memoryBytes();
+    g.enableShortestPathCache(treeBytes + treeBytes / 2);
+    cache = g.shortestPathCache();
+    ariel::Algorithms::shortestPath(g, 0, 3);
+    ariel::Algorithms::shortestPath(g, 1, 3);
+    ariel::Algorithms::shortestPath(g, 1, 3);
+    CHECK(cache->evictions() == 1);
+    CHECK(cache->hits() == 1);
+    CHECK(cache->bytes() <= cache->capacityBytes());
+}
+
+TEST_CASE("Test edge updates keep the sparse views and statistics in sync")
+{
+    // Random edits, read back every few steps, must match a graph freshly loaded from the same matrix
+    size_t n = 40;
+    vector<vector<int>> matrix(n, vector<int>(n, 0));
+    ariel::Graph g;
+    g.loadGraph(matrix);
+    unsigned long long state = 30;
+    bool same = true;
+    for (size_t step = 0; step < 2000; step++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        size_t u = (state >> 33) % n, v = (state >> 40) % n;
+        int weight = static_cast<int>((state >> 20) % 21) - 10;
+        if (u == v) {
+            continue;
+        }
+        if (weight == 0) {
+            g.removeEdge(u, v);
+        } else {
+            g.addEdge(u, v, weight);
+        }
+        matrix[u][v] = weight;
+        if (step % 7 == 0) {
+            ariel::Graph fresh;
+            fresh.loadGraph(matrix);
+            const ariel::WeightStatistics &a = g.weightStatistics(), &b = fresh.weightStatistics();
+            same = same && a.minWeight == b.minWeight && a.maxWeight == b.maxWeight && a.negativeEdges == b.negativeEdges;
+            same = same && g.outEdges().offsets == fresh.outEdges().offsets && g.outEdges().targets == fresh.outEdges().targets;
+            same = same && g.outEdges().weights == fresh.outEdges().weights && g.inEdges().targets == fresh.inEdges().targets;
+            same = same && g.inEdges().offsets == fresh.inEdges().offsets && g.inEdges().weights == fresh.inEdges().weights;
+            same = same && g.isSymmetric() == fresh.isSymmetric();
+        }
+    }
+    CHECK(same);
+}
+
+TEST_CASE("Test hub labels")
+{
+    ariel::Graph g;
+    vector<vector<int>> graph = {
+        {0, 4, 1, 0, 0, 0},
+        {0, 0, 0, 1, 0, 0},
+        {0, 2, 0, 5, 0, 0},
+        {0, 0, 0, 0, 3, 0},
+        {6, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 2, 0}};
+    g.loadGraph(graph);
+    ariel::HubLabels labels = ariel::HubLabels::build(g);
+    CHECK(labels.vertexCount() == 6);
+    CHECK(labels.distance(0, 4) == 7);
+    CHECK(labels.distance(4, 3) == 10);
+    CHECK(labels.distance(2, 2) == 0);
+    CHECK(labels.distance(0, 5) == ariel::Algorithms::UNREACHABLE);
+
+    // Every pair matches the shortest path distances, also when built by several threads
+    ariel::Parallel::setWorkers(3);
+    ariel::HubLabels parallelLabels = ariel::HubLabels::build(g);
+    ariel::Parallel::setWorkers(0);
+    bool allMatch = true;
+    for (size_t s = 0; s < 6; s++) {
+        ariel::ShortestPathTree tree = ariel::Algorithms::singleSourceShortestPaths(g, s);
+        for (size_t t = 0; t < 6; t++) {
+            allMatch = allMatch && labels.distance(s, t) == tree.distance[t] && parallelLabels.distance(s, t) == tree.distance[t];
+        }
+    }
+    CHECK(allMatch);
+
+    // Round trip through a memory-mapped file
+    labels.save("hub_labels_test.bin");
+    ariel::HubLabels mapped = ariel::HubLabels::load("hub_labels_test.bin");
+    std::remove("hub_labels_test.bin");
+    CHECK(mapped.labelEntries() == labels.labelEntries());
+    CHECK(mapped.distance(4, 3) == 10);
+    CHECK(mapped.distance(0, 5) == ariel::Algorithms::UNREACHABLE);
+    CHECK_THROWS(mapped.distance(0, 6));
+    CHECK_THROWS(ariel::HubLabels::load("missing_hub_labels.bin"));
+
+    // Damaged files are rejected on load: a word is overwritten in a copy of the saved index
+    labels.save("hub_labels_test.bin");
+    ifstream saved("hub_labels_test.bin", ios::binary);
+    vector<unsigned long long> words(labels.labelEntries() + 64);
+    saved.read(reinterpret_cast<char *>(words.data()), static_cast<streamsize>(words.size() * sizeof(unsigned long long)));
+    words.resize(static_cast<size_t>(saved.gcount()) / sizeof(unsigned long long));
+    saved.close();
+    std::remove("hub_labels_test.bin");
+    auto loadWith = [&](size_t index, unsigned long long value) {
+        vector<unsigned long long> damaged = words;
+        damaged[index] = value;
+        ofstream file("hub_labels_test.bin", ios::binary | ios::trunc);
+        file.write(reinterpret_cast<const char *>(damaged.data()), static_cast<streamsize>(damaged.size() * sizeof(unsigned long long)));
+        file.close();
+        bool thrown = false;
+        try {
+            ariel::HubLabels::load("hub_labels_test.bin");
+        } catch (const std::runtime_error &) {
+            thrown = true;
+        }
+        std::remove("hub_labels_test.bin");
+        return thrown;
+    };
+    CHECK_FALSE(loadWith(0, words[0]));
+    CHECK(loadWith(1, 1ULL << 62));         // vertex count far beyond the file
+    CHECK(loadWith(5, 1ULL << 40));         // out-label of vertex 0 ends past the label array
+    CHECK(loadWith(4, 1));                  // out-labels do not start at 0
+    CHECK(loadWith(words.size() - 1, 99));  // hub id in the last word out of range
+
+    vector<vector<int>> negative = {
+        {0, -1},
+        {1, 0}};
+    g.loadGraph(negative);
+    CHECK_THROWS(ariel::HubLabels::build(g));
+}
+
+TEST_CASE("Test isConnected on a long path")
+{
+    ariel::Graph g;
+    size_t n = 3000;
+    vector<vector<int>> path(n, vector<int>(n, 0));
+    for (size_t i = 0; i + 1 < n; i++) {
+        path[i][i + 1] = 1;
+        path[i + 1][i] = 1;
+    }
+    g.loadGraph(path);
+    CHECK(ariel::Algorithms::isConnected(g) == true);
+    g.removeEdge(n / 2, n / 2 + 1);
+    CHECK(ariel::Algorithms::isConnected(g) == false);
+    g.addEdge(0, n - 1, 1);
+    CHECK(ariel::Algorithms::isConnected(g) == true);
+}
+
+TEST_CASE("Test connected components")
+{
+    ariel::Graph g;
+    // Two directed cycles {0,1,2} and {3,4} joined by 2->3, plus the isolated vertex 5
+    vector<vector<int>> graph = {
+        {0, 1, 0, 0, 0, 0},
+        {0, 0, 1, 0, 0, 0},
+        {1, 0, 0, 1, 0, 0},
+        {0, 0, 0, 0, 1, 0},
+        {0, 0, 0, 1, 0, 0},
+        {0, 0, 0, 0, 0, 0}};
+    g.loadGraph(graph);
+    ariel::Components strong = ariel::Algorithms::stronglyConnectedComponents(g);
+    CHECK(strong.count == 3);
+    CHECK(strong.component == vector<size_t>({0, 0, 0, 1, 1, 2}));
+    ariel::Parallel::setWorkers(4);
+    CHECK(ariel::Algorithms::parallelStronglyConnectedComponents(g).component == strong.component);
+    ariel::Parallel::setWorkers(0);
+    ariel::Components weak = ariel::Algorithms::weaklyConnectedComponents(g);
+    CHECK(weak.count == 2);
+    CHECK(weak.component == vector<size_t>({0, 0, 0, 0, 0, 1}));
+
+    CHECK(ariel::Algorithms::isConnected(g, ariel::Connectivity::Weak) == false);
+    g.addEdge(5, 0, 1);
+    CHECK(ariel::Algorithms::isConnected(g, ariel::Connectivity::Weak) == true);
+    CHECK(ariel::Algorithms::isConnected(g, ariel::Connectivity::Strong) == false);
+    CHECK(ariel::Algorithms::isConnected(g, ariel::Connectivity::Reachable) == false);
+    g.addEdge(4, 5, 1);
+    CHECK(ariel::Algorithms::isConnected(g, ariel::Connectivity::Strong) == true);
+
+    // Reachable from 0 is neither strong nor weak connectivity
+    vector<vector<int>> star = {
+        {0, 1, 1},
+        {0, 0, 0},
+        {0, 0, 0}};
+    g.loadGraph(star);
+    CHECK(ariel::Algorithms::isConnected(g) == true);
+    CHECK(ariel::Algorithms::isConnected(g, ariel::Connectivity::Strong) == false);
+    CHECK(ariel::Algorithms::isConnected(g, ariel::Connectivity::Weak) == true);
+
+    // A long chain of 2-cycles with a back edge: deep enough to overflow a recursive Tarjan
+    size_t n = 4000;
+    vector<vector<int>> chain(n, vector<int>(n, 0));
+    for (size_t i = 0; i + 1 < n; i++) {
+        chain[i][i + 1] = 1;
+        if (i % 2 == 0) {
+            chain[i + 1][i] = 1;
+        }
+    }
+    chain[n - 1][n - 2] = 1;
+    g.loadGraph(chain);
+    strong = ariel::Algorithms::stronglyConnectedComponents(g);
+    CHECK(strong.count == n / 2);
+    ariel::Parallel::setWorkers(3);
+    CHECK(ariel::Algorithms::parallelStronglyConnectedComponents(g).component == strong.component);
+    ariel::Parallel::setWorkers(0);
+}
+
+TEST_CASE("Test parallelConnectedComponents")
+{
+    ariel::Graph g;
+    vector<vector<int>> graph = {
+        {0, 1, 0, 0, 0, 0},
+        {0, 0, 1, 0, 0, 0},
+        {1, 0, 0, 1, 0, 0},
+        {0, 0, 0, 0, 1, 0},
+        {0, 0, 0, 1, 0, 0},
+        {0, 0, 0, 0, 0, 0}};
+    g.loadGraph(graph);
+    ariel::Components components = ariel::Algorithms::parallelConnectedComponents(g);
+    CHECK(components.count == 2);
+    CHECK(components.component == vector<size_t>({0, 0, 0, 0, 0, 1}));
+    CHECK(components.sizes == vector<size_t>({5, 1}));
+    CHECK(ariel::Algorithms::weaklyConnectedComponents(g).sizes == components.sizes);
+
+    // Several small rings plus one large ring whose edges all point away from the small ones
+    size_t n = 3000;
+    vector<vector<int>> rings(n, vector<int>(n, 0));
+    for (size_t i = 0; i < 30; i++) {
+        size_t base = i * 10;
+        for (size_t j = 0; j < 10; j++) {
+            rings[base + j][base + (j + 1) % 10] = 1;
+        }
+    }
+    for (size_t v = 300; v < n; v++) {
+        rings[v][v + 1 < n ? v + 1 : 300] = 1;
+    }
+    rings[300][5] = 1; // joins the first small ring to the large one through an edge leaving the large ring
+    g.loadGraph(rings);
+    ariel::Parallel::setWorkers(4);
+    components = ariel::Algorithms::parallelConnectedComponents(g);
+    ariel::Parallel::setWorkers(0);
+    CHECK(components.count == 30);
+    CHECK(components.component == ariel::Algorithms::weaklyConnectedComponents(g).component);
+    CHECK(components.sizes[0] == n - 290);
+    CHECK(ariel::Algorithms::isConnected(g, ariel::Connectivity::Weak) == false);
+}
+
+TEST_CASE("Test breadthFirstSearch")
+{
+    ariel::Graph g;
+    vector<vector<int>> graph = {
+        {0, 5, 0, 0, 9},
+        {0, 0, 5, 0, 0},
+        {0, 0, 0, 5, 0},
+        {0, 0, 0, 0, 5},
+        {0, 0, 0, 0, 0}};
+    g.loadGraph(graph);
+    const size_t unvisited = ariel::BreadthFirstTree::UNVISITED;
+    CHECK(ariel::Algorithms::hopDistances(g, 0) == vector<size_t>({0, 1, 2, 3, 1}));
+    CHECK(ariel::Algorithms::hopDistances(g, 2) == vector<size_t>({unvisited, unvisited, 0, 1, 2}));
+    CHECK(ariel::Algorithms::unweightedShortestPath(g, 0, 4) == "0->4");
+    CHECK(ariel::Algorithms::shortestPath(g, 0, 4) == "0->4");
+    CHECK(ariel::Algorithms::unweightedShortestPath(g, 0, 3) == "0->1->2->3");
+    CHECK(ariel::Algorithms::unweightedShortestPath(g, 4, 0) == "-1");
+
+    ariel::BreadthFirstTree tree = ariel::Algorithms::breadthFirstSearch(g, {4}, true);
+    CHECK(tree.reached == 5);
+    CHECK(tree.hops == vector<size_t>({1, 2, 2, 1, 0}));
+    CHECK(tree.parent[4] == unvisited);
+    tree = ariel::Algorithms::breadthFirstSearch(g, {1, 3});
+    CHECK(tree.root == vector<size_t>({unvisited, 1, 1, 3, 3}));
+
+    // A dense core with long tails makes the engine switch to bottom-up steps and back
+    size_t n = 2000;
+    vector<vector<int>> core(n, vector<int>(n, 0));
+    for (size_t i = 0; i < 200; i++) {
+        for (size_t j = 0; j < 200; j++) {
+            if (i != j && (i + j) % 3 != 0) {
+                core[i][j] = 1;
+            }
+        }
+    }
+    for (size_t v = 200; v < n; v++) {
+        core[v - 1][v] = 1;
+        core[v][v - 1] = 1;
+    }
+    g.loadGraph(core);
+    ariel::Parallel::setWorkers(4);
+    tree = ariel::Algorithms::breadthFirstSearch(g, {0});
+    ariel::Parallel::setWorkers(0);
+    CHECK(tree.reached == n);
+    CHECK(tree.hops[n - 1] == tree.hops[199] + n - 200);
+    bool parentsValid = true;
+    for (size_t v = 1; v < n; v++) {
+        parentsValid = parentsValid && core[tree.parent[v]][v] != 0 && tree.hops[tree.parent[v]] + 1 == tree.hops[v];
+    }
+    CHECK(parentsValid);
+    CHECK(ariel::Algorithms::isConnected(g) == true);
+    CHECK(ariel::Algorithms::isBipartite(g) == "0");
+}
+
+TEST_CASE("Test IncrementalConnectivity")
+{
+    ariel::Graph g;
+    vector<vector<int>> graph = {
+        {0, 1, 0, 0, 0},
+        {0, 0, 0, 0, 0},
+        {0, 0, 0, 1, 0},
+        {0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0}};
+    g.loadGraph(graph);
+    ariel::IncrementalConnectivity connectivity(g);
+    CHECK(connectivity.components() == 3);
+    CHECK(connectivity.connected(1, 0));
+    CHECK_FALSE(connectivity.connected(0, 2));
+    CHECK_FALSE(connectivity.isConnected());
+
+    connectivity.addEdge(3, 1, 4);
+    CHECK(g.matrix[3][1] == 4);
+    CHECK(connectivity.connected(0, 2));
+    CHECK(connectivity.componentSize(2) == 4);
+    connectivity.addEdge(4, 0, 2);
+    CHECK(connectivity.isConnected());
+    CHECK(connectivity.isConnected() == ariel::Algorithms::isConnected(g, ariel::Connectivity::Weak));
+
+    // Changes made directly on the graph are picked up on the next query
+    g.removeEdge(4, 0);
+    CHECK_FALSE(connectivity.isConnected());
+    CHECK(connectivity.components() == 2);
+    CHECK_THROWS(connectivity.connected(0, 5));
+    CHECK_THROWS(connectivity.addEdge(2, 2, 1));
+}
+
+TEST_CASE("Test DynamicConnectivity")
+{
+    ariel::Graph g;
+    vector<vector<int>> graph = {
+        {0, 1, 0, 1},
+        {1, 0, 1, 0},
+        {0, 1, 0, 1},
+        {1, 0, 1, 0}};
+    g.loadGraph(graph);
+    ariel::DynamicConnectivity connectivity(g);
+    CHECK(connectivity.isConnected());
+
+    // The 4-cycle survives losing one link, even in both directions
+    connectivity.removeEdge(0, 1);
+    CHECK(connectivity.isConnected());
+    connectivity.removeEdge(1, 0);
+    CHECK(connectivity.isConnected());
+    CHECK(g.matrix[0][1] == 0);
+    connectivity.removeEdge(2, 3);
+    CHECK(connectivity.isConnected());
+    connectivity.removeEdge(3, 2);
+    CHECK_FALSE(connectivity.isConnected());
+    CHECK(connectivity.components() == 2);
+    CHECK(connectivity.connected(0, 3));
+    CHECK(connectivity.connected(1, 2));
+    CHECK_FALSE(connectivity.connected(0, 2));
+    CHECK(connectivity.componentSize(1) == 2);
+
+    connectivity.addEdge(3, 2, 5);
+    CHECK(connectivity.isConnected());
+    CHECK_THROWS(connectivity.addEdge(1, 1, 1));
+    CHECK_THROWS(connectivity.connected(0, 4));
+
+    // Random insertions and deletions checked against a full recomputation
+    size_t n = 30;
+    ariel::Graph random;
+    random.loadGraph(vector<vector<int>>(n, vector<int>(n, 0)));
+    ariel::DynamicConnectivity dynamic(random);
+    unsigned long long state = 12345;
+    bool matches = true;
+    for (size_t step = 0; step < 3000 && matches; step++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        size_t u = static_cast<size_t>(state >> 33) % n;
+        size_t v = static_cast<size_t>(state >> 17) % n;
+        if (u == v) {
+            continue;
+        }
+        // Keep the graph around the connectivity threshold so components keep splitting and merging
+        if (random.outEdges().edgeCount() < 2 * n && (state & 1) == 0) {
+            dynamic.addEdge(u, v, 1);
+        } else {
+            dynamic.removeEdge(u, v);
+        }
+        ariel::Components expected = ariel::Algorithms::weaklyConnectedComponents(random);
+        matches = dynamic.components() == expected.count;
+        for (size_t x = 0; x < n && matches; x++) {
+            matches = dynamic.connected(x, 0) == (expected.component[x] == expected.component[0]) &&
+                      dynamic.componentSize(x) == expected.sizes[expected.component[x]];
+        }
+    }
+    CHECK(matches);
+
+    // Changes made directly on the graph are picked up on the next query
+    g.removeEdge(3, 2);
+    CHECK_FALSE(connectivity.isConnected());
+}
+
+TEST_CASE("Test findDirectedCycle and findUndirectedCycle")
+{
+    ariel::Graph g;
+    vector<vector<int>> dag = {
+        {0, 1, 1, 0},
+        {0, 0, 1, 1},
+        {0, 0, 0, 1},
+        {0, 0, 0, 0}};
+    g.loadGraph(dag);
+    CHECK_FALSE(g.isSymmetric());
+    CHECK(ariel::Algorithms::findDirectedCycle(g).empty());
+    CHECK(ariel::Algorithms::findUndirectedCycle(g) == vector<size_t>({1, 2, 3, 1}));
+    CHECK(ariel::Algorithms::isContainsCycle(g) == "0");
+
+    g.addEdge(3, 1, 2);
+    CHECK(ariel::Algorithms::findDirectedCycle(g) == vector<size_t>({1, 2, 3, 1}));
+    CHECK(ariel::Algorithms::isContainsCycle(g) == "1");
+
+    // A symmetric tree: every edge is its own 2-cycle when directed, but there is no undirected cycle
+    vector<vector<int>> tree = {
+        {0, 1, 1, 0},
+        {1, 0, 0, 1},
+        {1, 0, 0, 0},
+        {0, 1, 0, 0}};
+    g.loadGraph(tree);
+    CHECK(g.isSymmetric());
+    CHECK(ariel::Algorithms::findUndirectedCycle(g).empty());
+    CHECK(ariel::Algorithms::findDirectedCycle(g) == vector<size_t>({0, 1, 0}));
+    CHECK(ariel::Algorithms::isContainsCycle(g) == "0");
+    g.addEdge(3, 2, 1);
+    CHECK_FALSE(g.isSymmetric());
+    g.addEdge(2, 3, 1);
+    CHECK(g.isSymmetric());
+    CHECK(ariel::Algorithms::findUndirectedCycle(g) == vector<size_t>({0, 1, 3, 2, 0}));
+    g.removeEdge(1, 3);
+    CHECK_FALSE(g.isSymmetric());
+    g.removeEdge(3, 1);
+    CHECK(g.isSymmetric());
+    CHECK(ariel::Algorithms::isContainsCycle(g) == "0");
+
+    // A long path closed into one big cycle, deeper than a recursive DFS could go
+    size_t n = 3000;
+    vector<vector<int>> ring(n, vector<int>(n, 0));
+    for (size_t i = 0; i + 1 < n; i++) {
+        ring[i][i + 1] = 1;
+    }
+    g.loadGraph(ring);
+    CHECK(ariel::Algorithms::findDirectedCycle(g).empty());
+    g.addEdge(n - 1, 0, 1);
+    vector<size_t> cycle = ariel::Algorithms::findDirectedCycle(g);
+    CHECK(cycle.size() == n + 1);
+    bool edgesExist = cycle.front() == cycle.back();
+    for (size_t i = 0; i + 1 < cycle.size(); i++) {
+        edgesExist = edgesExist && g.matrix[cycle[i]][cycle[i + 1]] != 0;
+    }
+    CHECK(edgesExist);
+}
+
+TEST_CASE("Test topologicalSort and DAG paths")
+{
+    ariel::Graph g;
+    vector<vector<int>> graph = {
+        {0, 5, 3, 0, 0, 0},
+        {0, 0, 2, 6, 0, 0},
+        {0, 0, 0, 7, 4, 2},
+        {0, 0, 0, 0, -1, 1},
+        {0, 0, 0, 0, 0, -2},
+        {0, 0, 0, 0, 0, 0}};
+    g.loadGraph(graph);
+    CHECK(g.acyclicity() == ariel::Acyclicity::Unknown);
+    CHECK(ariel::Algorithms::topologicalSort(g) == vector<size_t>({0, 1, 2, 3, 4, 5}));
+    CHECK(g.acyclicity() == ariel::Acyclicity::Acyclic);
+    ariel::Parallel::setWorkers(4);
+    CHECK(ariel::Algorithms::parallelTopologicalSort(g) == vector<size_t>({0, 1, 2, 3, 4, 5}));
+    ariel::Parallel::setWorkers(0);
+
+    ariel::ShortestPathTree shortest = ariel::Algorithms::dagShortestPaths(g, 1);
+    CHECK(shortest.distance == vector<long long>({ariel::Algorithms::UNREACHABLE, 0, 2, 6, 5, 3}));
+    CHECK(shortest.pathString(5) == "1->3->4->5");
+    ariel::ShortestPathTree longest = ariel::Algorithms::dagLongestPaths(g, 0);
+    CHECK(longest.distance == vector<long long>({0, 5, 7, 14, 13, 15}));
+    CHECK(longest.pathString(5) == "0->1->2->3->5");
+    CHECK(ariel::Algorithms::shortestPath(g, 1, 5) == "1->3->4->5");
+
+    // Removing an edge keeps the graph acyclic, adding one makes the status unknown again
+    g.removeEdge(0, 2);
+    CHECK(g.acyclicity() == ariel::Acyclicity::Acyclic);
+    g.addEdge(5, 0, 1);
+    CHECK(g.acyclicity() == ariel::Acyclicity::Unknown);
+    CHECK_THROWS(ariel::Algorithms::topologicalSort(g));
+    CHECK(g.acyclicity() == ariel::Acyclicity::Cyclic);
+    CHECK_THROWS(ariel::Algorithms::parallelTopologicalSort(g));
+    CHECK_THROWS(ariel::Algorithms::dagShortestPaths(g, 0));
+    CHECK(ariel::Algorithms::shortestPath(g, 1, 5) == "1->3->4->5");
+    CHECK_THROWS(ariel::Algorithms::dagLongestPaths(g, 6));
+
+    // A larger layered DAG: every order is valid, and the DAG distances match Dial's algorithm
+    size_t n = 400;
+    vector<vector<int>> layered(n, vector<int>(n, 0));
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = i + 1; j < n && j < i + 30; j++) {
+            if ((i * 7 + j * 13) % 5 == 0) {
+                layered[n - 1 - i][n - 1 - j] = static_cast<int>((i * j) % 17 + 1);
+            }
+        }
+    }
+    g.loadGraph(layered);
+    ariel::ShortestPathTree dial = ariel::Algorithms::singleSourceShortestPaths(g, n - 1);
+    ariel::Parallel::setWorkers(4);
+    vector<size_t> order = ariel::Algorithms::parallelTopologicalSort(g);
+    ariel::Parallel::setWorkers(0);
+    vector<size_t> position(n);
+    for (size_t i = 0; i < order.size(); i++) {
+        position[order[i]] = i;
+    }
+    bool forward = order.size() == n;
+    for (size_t u = 0; u < n; u++) {
+        for (size_t v = 0; v < n; v++) {
+            forward = forward && (layered[u][v] == 0 || position[u] < position[v]);
+        }
+    }
+    CHECK(forward);
+    CHECK(ariel::Algorithms::dagShortestPaths(g, n - 1).distance == dial.distance);
+}
+
+TEST_CASE("Test OnlineTopologicalOrder")
+{
+    ariel::Graph g;
+    vector<vector<int>> graph = {
+        {0, 1, 0, 0, 0},
+        {0, 0, 0, 0, 0},
+        {0, 0, 0, 1, 0},
+        {0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0}};
+    g.loadGraph(graph);
+    ariel::OnlineTopologicalOrder topological(g);
+    CHECK(topological.order() == vector<size_t>({0, 2, 4, 1, 3}));
+
+    // 3->0 points backwards: 3 and 0 swap ranks
+    CHECK(topological.addEdge(3, 0, 2).empty());
+    CHECK(g.matrix[3][0] == 2);
+    CHECK(topological.position(3) < topological.position(0));
+    CHECK(topological.addEdge(1, 2, 1) == vector<size_t>({2, 3, 0, 1, 2}));
+    CHECK(g.matrix[1][2] == 0);
+    CHECK(topological.addEdge(0, 1, 5).empty());
+    CHECK(g.matrix[0][1] == 5);
+    CHECK(topological.addEdge(1, 4, 1).empty());
+    CHECK(topological.addEdge(4, 2, 1) == vector<size_t>({2, 3, 0, 1, 4, 2}));
+    CHECK_THROWS(topological.addEdge(1, 1, 1));
+    CHECK_THROWS(topological.addEdge(1, 5, 1));
+    CHECK_THROWS(topological.addEdge(1, 3, 0));
+
+    // Removing 2->3 breaks the cycle, so 4->2 can now be added
+    topological.removeEdge(2, 3);
+    CHECK(topological.addEdge(4, 2, 1).empty());
+    CHECK(g.acyclicity() == ariel::Acyclicity::Acyclic);
+
+    // Random insertions: an edge is rejected exactly when the graph would get a cycle, and the order stays valid
+    size_t n = 60;
+    ariel::Graph random;
+    random.loadGraph(vector<vector<int>>(n, vector<int>(n, 0)));
+    ariel::OnlineTopologicalOrder online(random);
+    unsigned long long state = 777;
+    bool consistent = true;
+    for (size_t step = 0; step < 600 && consistent; step++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        size_t u = static_cast<size_t>(state >> 33) % n;
+        size_t v = static_cast<size_t>(state >> 17) % n;
+        if (u == v) {
+            continue;
+        }
+        bool reachable = ariel::Algorithms::hopDistances(random, v)[u] != ariel::BreadthFirstTree::UNVISITED;
+        vector<size_t> cycle = online.addEdge(u, v, 1);
+        consistent = cycle.empty() != reachable;
+        for (size_t i = 0; i + 1 < cycle.size() && consistent; i++) {
+            consistent = (cycle[i] == u && cycle[i + 1] == v) || random.matrix[cycle[i]][cycle[i + 1]] != 0;
+        }
+    }
+    for (size_t u = 0; u < n; u++) {
+        for (size_t v = 0; v < n; v++) {
+            consistent = consistent && (random.matrix[u][v] == 0 || online.position(u) < online.position(v));
+        }
+    }
+    CHECK(consistent);
+    CHECK(random.outEdges().edgeCount() > n);
+
+    // A graph with a cycle cannot be ordered
+    g.addEdge(2, 0, 1);
+    CHECK_THROWS(ariel::OnlineTopologicalOrder(g));
+    CHECK_THROWS(topological.order());
+}
+
+TEST_CASE("Test elementaryCycles")
+{
+    ariel::Graph g;
+    vector<vector<int>> graph = {
+        {0, 1, 0, 0, 0},
+        {0, 0, 1, 1, 0},
+        {1, 0, 0, 1, 0},
+        {1, 0, 0, 0, 1},
+        {0, 0, 0, 0, 0}};
+    g.loadGraph(graph);
+    vector<vector<size_t>> cycles;
+    auto collect = [&](const vector<size_t> &cycle) {
+        cycles.push_back(cycle);
+        return true;
+    };
+    CHECK(ariel::Algorithms::elementaryCycles(g, collect) == 3);
+    CHECK(cycles == vector<vector<size_t>>({{0, 1, 2, 0}, {0, 1, 2, 3, 0}, {0, 1, 3, 0}}));
+
+    cycles.clear();
+    CHECK(ariel::Algorithms::elementaryCycles(g, collect, 3) == 2);
+    CHECK(cycles == vector<vector<size_t>>({{0, 1, 2, 0}, {0, 1, 3, 0}}));
+    CHECK(ariel::Algorithms::elementaryCycles(g, collect, 2) == 0);
+
+    // visit can stop the enumeration
+    size_t visited = 0;
+    CHECK(ariel::Algorithms::elementaryCycles(g, [&](const vector<size_t> &) { return ++visited < 2; }) == 2);
+
+    // The complete directed graph on 6 vertices has sum over k of C(6, k) * (k - 1)! = 409 cycles, 55 of length <= 3
+    vector<vector<int>> complete(6, vector<int>(6, 1));
+    for (size_t i = 0; i < 6; i++) {
+        complete[i][i] = 0;
+    }
+    g.loadGraph(complete);
+    auto count = [](const vector<size_t> &) { return true; };
+    CHECK(ariel::Algorithms::elementaryCycles(g, count) == 409);
+    CHECK(ariel::Algorithms::elementaryCycles(g, count, 3) == 55);
+    ariel::Parallel::setWorkers(4);
+    CHECK(ariel::Algorithms::parallelElementaryCycles(g, count) == 409);
+    CHECK(ariel::Algorithms::parallelElementaryCycles(g, count, 3) == 55);
+    visited = 0;
+    CHECK(ariel::Algorithms::parallelElementaryCycles(g, [&](const vector<size_t> &) { return ++visited < 10; }) == 10);
+    ariel::Parallel::setWorkers(0);
+
+    // Acyclic graphs have no cycles to report
+    g.loadGraph({{0, 1, 1}, {0, 0, 1}, {0, 0, 0}});
+    CHECK(ariel::Algorithms::elementaryCycles(g, count) == 0);
+}
+
+TEST_CASE("Test girth and shortestCycle")
+{
+    ariel::Graph g;
+    // Undirected: a triangle 0-1-2 (weight 30) and a square 2-3-4-5 (weight 4)
+    vector<vector<int>> graph = {
+        {0, 10, 10, 0, 0, 0},
+        {10, 0, 10, 0, 0, 0},
+        {10, 10, 0, 1, 0, 1},
+        {0, 0, 1, 0, 1, 0},
+        {0, 0, 0, 1, 0, 1},
+        {0, 0, 1, 0, 1, 0}};
+    g.loadGraph(graph);
+    CHECK(ariel::Algorithms::girth(g) == 3);
+    ariel::Path cycle = ariel::Algorithms::shortestCycle(g);
+    CHECK(cycle.weight == 4);
+    CHECK(cycle.vertices.size() == 5);
+    CHECK(cycle.vertices.front() == cycle.vertices.back());
+
+    // Directed: 0->1->0 is the shortest cycle, 2->3->4->2 the lightest
+    vector<vector<int>> directed = {
+        {0, 5, 0, 0, 0},
+        {5, 0, 1, 0, 0},
+        {0, 0, 0, 1, 0},
+        {0, 0, 0, 0, 1},
+        {0, 0, 1, 0, 0}};
+    g.loadGraph(directed);
+    CHECK(ariel::Algorithms::girth(g) == 2);
+    cycle = ariel::Algorithms::shortestCycle(g);
+    CHECK(cycle.vertices == vector<size_t>({2, 3, 4, 2}));
+    CHECK(cycle.weight == 3);
+
+    // Trees and DAGs have no cycle, and negative weights are rejected
+    g.loadGraph({{0, 1, 1}, {1, 0, 0}, {1, 0, 0}});
+    CHECK(ariel::Algorithms::girth(g) == ariel::Algorithms::UNREACHABLE);
+    CHECK(ariel::Algorithms::shortestCycle(g).vertices.empty());
+    g.loadGraph({{0, 1, 1}, {0, 0, -1}, {0, 0, 0}});
+    CHECK(ariel::Algorithms::girth(g) == ariel::Algorithms::UNREACHABLE);
+    CHECK_THROWS(ariel::Algorithms::shortestCycle(g));
+
+    // An undirected 12x12 grid has girth 4, on several threads
+    size_t side = 12, n = side * side;
+    vector<vector<int>> grid(n, vector<int>(n, 0));
+    for (size_t r = 0; r < side; r++) {
+        for (size_t c = 0; c < side; c++) {
+            size_t v = r * side + c;
+            if (c + 1 < side) {
+                grid[v][v + 1] = grid[v + 1][v] = static_cast<int>(1 + v % 3);
+            }
+            if (r + 1 < side) {
+                grid[v][v + side] = grid[v + side][v] = static_cast<int>(1 + v % 5);
+            }
+        }
+    }
+    g.loadGraph(grid);
+    ariel::Parallel::setWorkers(4);
+    CHECK(ariel::Algorithms::girth(g) == 4);
+    cycle = ariel::Algorithms::shortestCycle(g);
+    ariel::Parallel::setWorkers(0);
+    CHECK(cycle.vertices.size() == 5);
+    CHECK(cycle.weight == ariel::Algorithms::shortestCycle(g).weight);
+}
+
+TEST_CASE("Test IncrementalBipartiteness")
+{
+    ariel::Graph g;
+    vector<vector<int>> graph = {
+        {0, 1, 0, 0, 0},
+        {0, 0, 1, 0, 0},
+        {0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 1},
+        {0, 0, 0, 0, 0}};
+    g.loadGraph(graph);
+    ariel::IncrementalBipartiteness bipartite(g);
+    CHECK(bipartite.isBipartite());
+    CHECK(bipartite.coloring() == vector<size_t>({0, 1, 0, 0, 1}));
+    CHECK(bipartite.oddCycle().empty());
+
+    // Joining the two paths keeps a 2-coloring, 4-0 then closes the odd cycle along the forest 4-3-2-1-0
+    CHECK(bipartite.addEdge(2, 3, 1));
+    vector<size_t> sides = bipartite.coloring();
+    CHECK(sides[2] != sides[3]);
+    CHECK(sides[0] != sides[1]);
+    CHECK(bipartite.addEdge(0, 3, 1));
+    CHECK_FALSE(bipartite.addEdge(4, 0, 1));
+    CHECK(g.matrix[4][0] == 1);
+    CHECK_FALSE(bipartite.isBipartite());
+    CHECK(bipartite.oddCycle() == vector<size_t>({4, 3, 2, 1, 0, 4}));
+    CHECK(bipartite.coloring().empty());
+    CHECK_FALSE(bipartite.addEdge(1, 4, 1));
+    CHECK(bipartite.oddCycle() == vector<size_t>({4, 3, 2, 1, 0, 4}));
+    CHECK_THROWS(bipartite.addEdge(5, 0, 1));
+
+    // Removing an edge from the graph is picked up on the next call
+    g.removeEdge(4, 0);
+    CHECK(bipartite.isBipartite());
+    CHECK(bipartite.isBipartite() == (ariel::Algorithms::isBipartite(g) != "0"));
+
+    // A long even cycle stays bipartite, one chord across an odd distance breaks it
+    size_t n = 1000;
+    ariel::Graph ring;
+    ring.loadGraph(vector<vector<int>>(n, vector<int>(n, 0)));
+    ariel::IncrementalBipartiteness stream(ring);
+    bool bipartiteRing = true;
+    for (size_t i = 0; i < n; i++) {
+        bipartiteRing = bipartiteRing && stream.addEdge(i, (i + 1) % n, 1);
+    }
+    CHECK(bipartiteRing);
+    CHECK_FALSE(stream.addEdge(0, 500, 1));
+    vector<size_t> cycle = stream.oddCycle();
+    CHECK(cycle.size() % 2 == 0);
+    bool edgesExist = cycle.front() == cycle.back();
+    for (size_t i = 0; i + 1 < cycle.size(); i++) {
+        edgesExist = edgesExist && (ring.matrix[cycle[i]][cycle[i + 1]] != 0 || ring.matrix[cycle[i + 1]][cycle[i]] != 0);
+    }
+    CHECK(edgesExist);
+}
+
+TEST_CASE("Test bipartition")
+{
+    ariel::Graph g;
+    vector<vector<int>> graph = {
+        {0, 1, 0, 0, 0, 0},
+        {0, 0, 1, 0, 0, 0},
+        {0, 0, 0, 1, 0, 0},
+        {1, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 1},
+        {0, 0, 0, 0, 0, 0}};
+    g.loadGraph(graph);
+    ariel::Bipartition result = ariel::Algorithms::bipartition(g);
+    CHECK(result.bipartite);
+    CHECK(result.partA == vector<size_t>({0, 2, 4}));
+    CHECK(result.partB == vector<size_t>({1, 3, 5}));
+    CHECK(result.oddCycle.empty());
+
+    // 1->3 splits the square into two triangles
+    g.addEdge(1, 3, 1);
+    result = ariel::Algorithms::bipartition(g);
+    CHECK_FALSE(result.bipartite);
+    CHECK(result.oddCycle == vector<size_t>({1, 0, 3, 1}));
+    CHECK(result.partA.empty());
+    CHECK(ariel::Algorithms::isBipartite(g) == "0");
+
+    // A 40x40 grid is bipartite; one diagonal edge far from the sources makes a certified odd cycle
+    size_t side = 40, n = side * side;
+    vector<vector<int>> grid(n, vector<int>(n, 0));
+    for (size_t r = 0; r < side; r++) {
+        for (size_t c = 0; c < side; c++) {
+            size_t v = r * side + c;
+            if (c + 1 < side) {
+                grid[v][v + 1] = 1;
+            }
+            if (r + 1 < side) {
+                grid[v + side][v] = 1;
+            }
+        }
+    }
+    g.loadGraph(grid);
+    ariel::Parallel::setWorkers(4);
+    result = ariel::Algorithms::bipartition(g);
+    CHECK(result.bipartite);
+    CHECK(result.partA.size() == n / 2);
+    g.addEdge(n - 1, n - side - 2, 1);
+    result = ariel::Algorithms::bipartition(g);
+    ariel::Parallel::setWorkers(0);
+    CHECK_FALSE(result.bipartite);
+    vector<size_t> &cycle = result.oddCycle;
+    CHECK(cycle.size() % 2 == 0);
+    bool edgesExist = cycle.front() == cycle.back();
+    for (size_t i = 0; i + 1 < cycle.size(); i++) {
+        edgesExist = edgesExist && (g.matrix[cycle[i]][cycle[i + 1]] != 0 || g.matrix[cycle[i + 1]][cycle[i]] != 0);
+    }
+    CHECK(edgesExist);
+}
+
+TEST_CASE("Test maximumMatching")
+{
+    ariel::Graph g;
+    // Left {0, 1, 2}, right {3, 4, 5}: 0 and 1 only like 3, so one of them stays unmatched
+    vector<vector<int>> graph = {
+        {0, 0, 0, 1, 0, 0},
+        {0, 0, 0, 1, 0, 0},
+        {0, 0, 0, 1, 1, 1},
+        {0, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 0}};
+    g.loadGraph(graph);
+    ariel::Matching matching = ariel::Algorithms::maximumMatching(g);
+    CHECK(matching.size == 2);
+    CHECK(matching.vertexCover == vector<size_t>({2, 3}));
+    CHECK(matching.mate[2] != ariel::Matching::UNMATCHED);
+    CHECK(matching.mate[matching.mate[2]] == 2);
+    CHECK((matching.mate[0] == 3) != (matching.mate[1] == 3));
+
+    // The partition of an earlier bipartiteness check can be reused; the parallel version agrees
+    ariel::Bipartition parts = ariel::Algorithms::bipartition(g);
+    ariel::Parallel::setWorkers(4);
+    ariel::Matching parallel = ariel::Algorithms::parallelMaximumMatching(g, parts);
+    ariel::Parallel::setWorkers(0);
+    CHECK(parallel.size == 2);
+    CHECK(parallel.vertexCover.size() == 2);
+
+    // Odd cycles have no bipartite matching
+    g.loadGraph({{0, 1, 1}, {1, 0, 1}, {1, 1, 0}});
+    CHECK_THROWS(ariel::Algorithms::maximumMatching(g));
+    CHECK_THROWS(ariel::Algorithms::parallelMaximumMatching(g));
+
+    // An even cycle of 200 vertices (stored in both directions) has a perfect matching
+    size_t n = 200;
+    vector<vector<int>> ring(n, vector<int>(n, 0));
+    for (size_t i = 0; i < n; i++) {
+        ring[i][(i + 1) % n] = ring[(i + 1) % n][i] = 1;
+    }
+    g.loadGraph(ring);
+    matching = ariel::Algorithms::maximumMatching(g);
+    CHECK(matching.size == n / 2);
+    CHECK(matching.vertexCover.size() == n / 2);
+    ariel::Parallel::setWorkers(4);
+    CHECK(ariel::Algorithms::parallelMaximumMatching(g).size == n / 2);
+    ariel::Parallel::setWorkers(0);
+    bool valid = true;
+    for (size_t v = 0; v < n; v++) {
+        valid = valid && matching.mate[v] != ariel::Matching::UNMATCHED && ring[v][matching.mate[v]] != 0;
+    }
+    CHECK(valid);
+}
+
+TEST_CASE("Test minimumCostAssignment")
+{
+    ariel::Graph g;
+    // Workers {0, 1, 2}, jobs {3, 4, 5}: the cheapest assignment is 0-4, 1-3, 2-5 with cost 2 + 1 + 3
+    vector<vector<int>> graph = {
+        {0, 0, 0, 4, 2, 8},
+        {0, 0, 0, 1, 5, 7},
+        {0, 0, 0, 3, 6, 3},
+        {0, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 0}};
+    g.loadGraph(graph);
+    ariel::Assignment assignment = ariel::Algorithms::minimumCostAssignment(g);
+    CHECK(assignment.cost == 6);
+    CHECK(assignment.size == 3);
+    CHECK(assignment.mate == vector<size_t>({4, 3, 5, 1, 0, 2}));
+    ariel::Parallel::setWorkers(4);
+    ariel::Assignment parallel = ariel::Algorithms::parallelMinimumCostAssignment(g);
+    ariel::Parallel::setWorkers(0);
+    CHECK(parallel.cost == 6);
+    CHECK(parallel.mate == assignment.mate);
+
+    // Negative weights and an unbalanced graph: only the two workers {0, 1} are assigned, to jobs {2, 3, 4}
+    g.loadGraph({
+        {0, 0, -5, 3, 1},
+        {0, 0, -4, 0, -6},
+        {-5, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0}});
+    assignment = ariel::Algorithms::minimumCostAssignment(g);
+    CHECK(assignment.cost == -11);
+    CHECK(assignment.size == 2);
+    CHECK(assignment.mate[3] == ariel::Matching::UNMATCHED);
+    CHECK(ariel::Algorithms::parallelMinimumCostAssignment(g).cost == -11);
+
+    // Workers 0 and 1 both only have job 3, and odd cycles are not bipartite
+    g.loadGraph({
+        {0, 0, 0, 1, 0, 0},
+        {0, 0, 0, 1, 0, 0},
+        {0, 0, 0, 1, 1, 1},
+        {0, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 0}});
+    CHECK_THROWS(ariel::Algorithms::minimumCostAssignment(g));
+    CHECK_THROWS(ariel::Algorithms::parallelMinimumCostAssignment(g));
+    g.loadGraph({{0, 1, 1}, {1, 0, 1}, {1, 1, 0}});
+    CHECK_THROWS(ariel::Algorithms::minimumCostAssignment(g));
+
+    // Random sparse instance: 150 workers, 150 jobs, a diagonal keeps it feasible; both algorithms find the same cost
+    size_t n = 150;
+    vector<vector<int>> random(2 * n, vector<int>(2 * n, 0));
+    unsigned long long state = 46;
+    for (size_t i = 0; i < n; i++) {
+        random[i][n + i] = 500;
+        for (size_t k = 0; k < 6; k++) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            random[i][n + (state >> 33) % n] = static_cast<int>((state >> 20) % 400) - 100 + 1000 * ((state >> 50) % 2 == 0 ? 0 : 1) + 1;
+        }
+    }
+    ariel::Bipartition parts;
+    for (size_t i = 0; i < n; i++) {
+        parts.partA.push_back(i);
+        parts.partB.push_back(n + i);
+    }
+    g.loadGraph(random);
+    assignment = ariel::Algorithms::minimumCostAssignment(g, parts);
+    ariel::Parallel::setWorkers(4);
+    parallel = ariel::Algorithms::parallelMinimumCostAssignment(g, parts);
+    ariel::Parallel::setWorkers(0);
+    CHECK(assignment.size == n);
+    CHECK(parallel.size == n);
+    CHECK(parallel.cost == assignment.cost);
+    CHECK(assignment.cost < 500 * static_cast<long long>(n));
+}
+
+TEST_CASE("Test findNegativeCycle")
+{
+    ariel::Graph g;
+    // 1 -> 2 -> 3 -> 1 weighs 2 - 4 + 1 = -1, reachable from 0
+    vector<vector<int>> graph = {
+        {0, 5, 0, 0},
+        {0, 0, 2, 0},
+        {0, 0, 0, -4},
+        {0, 1, 0, 0}};
+    g.loadGraph(graph);
+    ariel::Path cycle = ariel::Algorithms::findNegativeCycle(g, 0);
+    CHECK(cycle.weight == -1);
+    CHECK(cycle.vertices.size() == 4);
+    CHECK(cycle.vertices.front() == cycle.vertices.back());
+    CHECK(ariel::Algorithms::negativeCycle(g).find("Negative cycle detected: ") == 0);
+    CHECK(g.acyclicity() == ariel::Acyclicity::Cyclic);
+    CHECK_THROWS(ariel::Algorithms::findNegativeCycle(g, 4));
+
+    // The cycle turns non-negative
+    g.addEdge(3, 1, 2);
+    CHECK(ariel::Algorithms::findNegativeCycle(g, 0).vertices.empty());
+    CHECK(ariel::Algorithms::negativeCycle(g) == "No negative cycle detected");
+
+    // Not reachable from the source
+    g.loadGraph({
+        {0, 1, 0},
+        {0, 0, 0},
+        {0, -2, 0}});
+    CHECK(ariel::Algorithms::findNegativeCycle(g, 0).vertices.empty());
+    g.loadGraph({
+        {0, 0, 0},
+        {0, 0, -3},
+        {1, 1, 0}});
+    CHECK(ariel::Algorithms::findNegativeCycle(g, 0).vertices.empty());
+    CHECK(ariel::Algorithms::findNegativeCycle(g, 1).weight == -2);
+
+    // A long positive ring with one strongly negative chord: the cycle through the chord is found
+    size_t n = 500;
+    vector<vector<int>> ring(n, vector<int>(n, 0));
+    for (size_t i = 0; i < n; i++) {
+        ring[i][(i + 1) % n] = 3;
+    }
+    ring[400][100] = -1000;
+    g.loadGraph(ring);
+    cycle = ariel::Algorithms::findNegativeCycle(g, 0);
+    CHECK(cycle.weight == 300 * 3 - 1000);
+    CHECK(cycle.vertices.size() == 302);
+    CHECK(cycle.vertices.front() == 100);
+    CHECK(ariel::Algorithms::singleSourceShortestPaths(g, 0).negativeCycle);
+}
+
+TEST_CASE("Test findNegativeCycle from a virtual source")
+{
+    ariel::Graph g;
+    // Vertex 0 reaches nothing, the cycle 1 -> 2 -> 1 is still found
+    vector<vector<int>> graph = {
+        {0, 0, 0},
+        {0, 0, -3},
+        {1, 1, 0}};
+    g.loadGraph(graph);
+    ariel::Path cycle = ariel::Algorithms::findNegativeCycle(g);
+    CHECK(cycle.weight == -2);
+    CHECK(cycle.vertices.size() == 3);
+    CHECK(ariel::Algorithms::negativeCycle(g).find("Negative cycle detected: ") == 0);
+
+    // Two disjoint negative cycles {0, 1} and {3, 4} joined by positive edges, and a non-negative cycle {5, 6}
+    g.loadGraph({
+        {0, -2, 0, 0, 0, 0, 0},
+        {1, 0, 4, 0, 0, 0, 0},
+        {0, 0, 0, 2, 0, 0, 0},
+        {0, 0, 0, 0, 3, 0, 0},
+        {0, 0, 0, -5, 0, 0, 0},
+        {0, 0, 0, 0, 0, 0, 1},
+        {0, 0, 0, 0, 0, -1, 0}});
+    vector<ariel::Path> cycles = ariel::Algorithms::disjointNegativeCycles(g);
+    CHECK(cycles.size() == 2);
+    long long total = 0;
+    for (const ariel::Path &c : cycles) {
+        total += c.weight;
+        CHECK(c.vertices.size() == 3);
+    }
+    CHECK(total == -3);
+    CHECK(ariel::Algorithms::disjointNegativeCycles(g, 1).size() == 1);
+
+    // No negative cycle anywhere
+    g.addEdge(1, 0, 2);
+    g.addEdge(4, 3, -3);
+    CHECK(ariel::Algorithms::findNegativeCycle(g).vertices.empty());
+    CHECK(ariel::Algorithms::disjointNegativeCycles(g).empty());
+    CHECK(ariel::Algorithms::negativeCycle(g) == "No negative cycle detected");
+    ariel::Graph empty;
+    CHECK(ariel::Algorithms::negativeCycle(empty) == "No negative cycle detected");
+
+    // 50 disjoint triangles of weight -1, linked in a chain by positive edges: all of them are enumerated
+    size_t n = 150;
+    vector<vector<int>> triangles(n, vector<int>(n, 0));
+    for (size_t t = 0; t < n; t += 3) {
+        triangles[t][t + 1] = 1;
+        triangles[t + 1][t + 2] = 1;
+        triangles[t + 2][t] = -3;
+        if (t + 3 < n) {
+            triangles[t + 2][t + 3] = 7;
+        }
+    }
+    g.loadGraph(triangles);
+    cycles = ariel::Algorithms::disjointNegativeCycles(g);
+    CHECK(cycles.size() == 50);
+    bool allNegative = true;
+    for (const ariel::Path &c : cycles) {
+        allNegative = allNegative && c.weight == -1;
+    }
+    CHECK(allNegative);
+}
+
+TEST_CASE("Test minimumMeanCycle")
+{
+    ariel::Graph g;
+    // Cycles 0 -> 1 -> 0 (mean 3), 1 -> 2 -> 3 -> 1 (mean 2) and, in another component, 4 -> 5 -> 4 (mean 2.5)
+    vector<vector<int>> graph = {
+        {0, 2, 0, 0, 0, 0},
+        {4, 0, 1, 0, 0, 0},
+        {0, 0, 0, 2, 0, 0},
+        {0, 3, 0, 0, 1, 0},
+        {0, 0, 0, 0, 0, 1},
+        {0, 0, 0, 0, 4, 0}};
+    g.loadGraph(graph);
+    ariel::Path cycle = ariel::Algorithms::minimumMeanCycle(g);
+    CHECK(cycle.weight == 6);
+    CHECK(cycle.vertices.size() == 4);
+    CHECK(cycle.vertices.front() == cycle.vertices.back());
+    CHECK(g.acyclicity() == ariel::Acyclicity::Cyclic);
+
+    // Lowering 4 -> 5 makes the other component's cycle the best one, with a negative mean
+    g.addEdge(4, 5, -6);
+    cycle = ariel::Algorithms::minimumMeanCycle(g);
+    CHECK(cycle.weight == -2);
+    CHECK(cycle.vertices.size() == 3);
+
+    // No cycle at all
+    g.loadGraph({
+        {0, 1, 1},
+        {0, 0, 1},
+        {0, 0, 0}});
+    CHECK(ariel::Algorithms::minimumMeanCycle(g).vertices.empty());
+    CHECK(g.acyclicity() == ariel::Acyclicity::Acyclic);
+
+    // 40 rings of 10 vertices in parallel, ring r weighs 10 * (r % 7) - 25 in total except ring 23 which weighs -31
+    size_t rings = 40, size = 10, n = rings * size;
+    vector<vector<int>> many(n, vector<int>(n, 0));
+    for (size_t r = 0; r < rings; r++) {
+        for (size_t i = 0; i < size; i++) {
+            many[r * size + i][r * size + (i + 1) % size] = i == 0 ? static_cast<int>(10 * (r % 7)) - 25 : 0;
+            if (many[r * size + i][r * size + (i + 1) % size] == 0) {
+                many[r * size + i][r * size + (i + 1) % size] = i % 2 == 0 ? 1 : -1;
+            }
+        }
+        if (r + 1 < rings) {
+            many[r * size][(r + 1) * size] = 5;
+        }
+    }
+    many[230][231] = -31;
+    g.loadGraph(many);
+    ariel::Parallel::setWorkers(4);
+    cycle = ariel::Algorithms::minimumMeanCycle(g);
+    ariel::Parallel::setWorkers(0);
+    CHECK(cycle.weight == -32);
+    CHECK(cycle.vertices.size() == size + 1);
+    CHECK(find(cycle.vertices.begin(), cycle.vertices.end(), 235) != cycle.vertices.end());
+}
+
+TEST_CASE("Test minimumMeanCycle with weights near INT_MAX")
+{
+    // Weights near +-INT_MAX push cycle weights and potentials far past 32 bits while means still differ by 1 / n^2,
+    // so the answer is checked exactly against Karp's recurrence over all start vertices
+    unsigned long long state = 49;
+    auto next = [&state]() {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<size_t>(state >> 33);
+    };
+    const long long NONE = LLONG_MAX;
+    bool exact = true, valid = true;
+    for (size_t trial = 0; trial < 12; trial++) {
+        size_t n = 12 + trial * 3;
+        vector<vector<int>> graph(n, vector<int>(n, 0));
+        for (size_t u = 0; u < n; u++) {
+            for (size_t v = 0; v < n; v++) {
+                if (u != v && next() % 5 == 0) {
+                    int weight = INT_MAX - static_cast<int>(next() % 1000);
+                    graph[u][v] = next() % 6 == 0 ? -weight : weight;
+                }
+            }
+        }
+        ariel::Graph g;
+        g.loadGraph(graph);
+        ariel::Path cycle = ariel::Algorithms::minimumMeanCycle(g);
+
+        // walk[k][v]: lightest walk of exactly k edges ending at v, starting anywhere
+        vector<vector<long long>> walk(n + 1, vector<long long>(n, NONE));
+        walk[0].assign(n, 0);
+        for (size_t k = 1; k <= n; k++) {
+            for (size_t u = 0; u < n; u++) {
+                for (size_t v = 0; v < n; v++) {
+                    if (graph[u][v] != 0 && walk[k - 1][u] != NONE) {
+                        walk[k][v] = min(walk[k][v], walk[k - 1][u] + graph[u][v]);
+                    }
+                }
+            }
+        }
+        long long bestNumerator = 0, bestDenominator = 0;
+        for (size_t v = 0; v < n; v++) {
+            if (walk[n][v] == NONE) {
+                continue;
+            }
+            long long numerator = 0, denominator = 0;
+            for (size_t k = 0; k < n; k++) {
+                long long top = walk[n][v] - walk[k][v];
+                long long bottom = static_cast<long long>(n - k);
+                if (walk[k][v] != NONE && (denominator == 0 || top * denominator > numerator * bottom)) {
+                    numerator = top;
+                    denominator = bottom;
+                }
+            }
+            if (bestDenominator == 0 || numerator * bestDenominator < bestNumerator * denominator) {
+                bestNumerator = numerator;
+                bestDenominator = denominator;
+            }
+        }
+        if (bestDenominator == 0) {
+            exact = exact && cycle.vertices.empty();
+            continue;
+        }
+
+        // The returned cycle uses real edges, adds up to its weight and has the minimum mean
+        long long weight = 0;
+        for (size_t i = 0; i + 1 < cycle.vertices.size(); i++) {
+            int edge = graph[cycle.vertices[i]][cycle.vertices[i + 1]];
+            valid = valid && edge != 0;
+            weight += edge;
+        }
+        valid = valid && cycle.vertices.size() > 2 && cycle.vertices.front() == cycle.vertices.back() && weight == cycle.weight;
+        long long length = static_cast<long long>(cycle.vertices.size()) - 1;
+        exact = exact && cycle.weight * bestDenominator == bestNumerator * length;
+    }
+    CHECK(valid);
+    CHECK(exact);
+}
+
+TEST_CASE("Test parallelBellmanFord")
+{
+    ariel::Graph g;
+    // Negative edges without a negative cycle; 1 <-> 2 is a zero-weight cycle
+    vector<vector<int>> graph = {
+        {0, 4, 0, 5},
+        {0, 0, -3, 0},
+        {0, 3, 0, 0},
+        {0, -2, -1, 0}};
+    g.loadGraph(graph);
+    ariel::Parallel::setWorkers(4);
+    ariel::ShortestPathTree tree = ariel::Algorithms::parallelBellmanFord(g, 0);
+    CHECK_FALSE(tree.negativeCycle);
+    CHECK(tree.distance == vector<long long>({0, 3, 0, 5}));
+    CHECK(tree.pathTo(2) == vector<size_t>({0, 3, 1, 2}));
+    CHECK(tree.pathTo(1) == vector<size_t>({0, 3, 1}));
+    CHECK_THROWS(ariel::Algorithms::parallelBellmanFord(g, 4));
+
+    // The same negative cycle the sequential search reports
+    g.addEdge(2, 1, 2);
+    CHECK(ariel::Algorithms::parallelBellmanFord(g, 0).negativeCycle);
+    CHECK_FALSE(ariel::Algorithms::findNegativeCycle(g, 0).vertices.empty());
+
+    // A large graph with negative weights (reduced costs of random potentials, so no negative cycle) takes the
+    // parallel path of singleSourceShortestPaths and agrees with the sequential one
+    size_t n = 5000;
+    vector<vector<int>> large(n, vector<int>(n, 0));
+    vector<int> potential(n);
+    unsigned long long state = 50;
+    for (size_t v = 0; v < n; v++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        potential[v] = static_cast<int>((state >> 33) % 1000);
+    }
+    for (size_t u = 0; u < n; u++) {
+        for (size_t k = 0; k < 8; k++) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            size_t v = (state >> 33) % n;
+            if (v != u) {
+                large[u][v] = static_cast<int>((state >> 20) % 100) + 1 + potential[u] - potential[v];
+                if (large[u][v] == 0) {
+                    large[u][v] = 1;
+                }
+            }
+        }
+    }
+    g.loadGraph(large);
+    ariel::ShortestPathTree parallel = ariel::Algorithms::singleSourceShortestPaths(g, 0);
+    ariel::Parallel::setWorkers(1);
+    ariel::ShortestPathTree sequential = ariel::Algorithms::singleSourceShortestPaths(g, 0);
+    ariel::Parallel::setWorkers(0);
+    CHECK_FALSE(parallel.negativeCycle);
+    CHECK(parallel.distance == sequential.distance);
+    bool consistent = true;
+    for (size_t v = 1; v < n; v++) {
+        if (parallel.hasPath(v)) {
+            size_t p = parallel.parent[v];
+            consistent = consistent && parallel.distance[p] + large[p][v] == parallel.distance[v];
+        }
+    }
+    CHECK(consistent);
+}
@@ -0,0 +1,50 @@
+#include "UnionFind.hpp"
+#include <utility>
+
+namespace ariel {
+
+    UnionFind::UnionFind(size_t elements) : parent(elements), setSize(elements, 1), setCount(elements) {
+        for (size_t i = 0; i < elements; i++) {
+            parent[i] = i;
+        }
+    }
+
+    size_t UnionFind::find(size_t x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]]; // path halving
+            x = parent[x];
+        }
+        return x;
+    }
+
+    bool UnionFind::unite(size_t a, size_t b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) {
+            return false;
+        }
+        if (setSize[a] < setSize[b]) {
+            swap(a, b);
+        }
+        parent[b] = a;
+        setSize[a] += setSize[b];
+        setCount--;
+        return true;
+    }
+
+    bool UnionFind::connected(size_t a, size_t b) {
+        return find(a) == find(b);
+    }
+
+    size_t UnionFind::size(size_t x) {
+        return setSize[find(x)];
+    }
+
+    size_t UnionFind::sets() const {
+        return setCount;
+    }
+
+    size_t UnionFind::elements() const {
+        return parent.size();
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef UNIONFIND_HPP
+#define UNIONFIND_HPP
+
+#include <vector>
+
+using namespace std;
+
+namespace ariel {
+    // Disjoint sets over 0..n-1 with union by size and path halving (near-constant amortized time per operation)
+    class UnionFind {
+    public:
+        explicit UnionFind(size_t elements = 0);
+
+        // Representative of the set containing x
+        size_t find(size_t x);
+
+        // Merge the sets of a and b, returns false if they were already the same set
+        bool unite(size_t a, size_t b);
+
+        bool connected(size_t a, size_t b);
+
+        // Number of elements in the set containing x
+        size_t size(size_t x);
+
+        // Number of disjoint sets
+        size_t sets() const;
+
+        size_t elements() const;
+
+    private:
+        vector<size_t> parent;
+        vector<size_t> setSize;
+        size_t setCount;
+    };
+}
+
+#endif